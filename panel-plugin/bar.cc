@@ -0,0 +1,420 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <math.h>
+#include <string.h>
+
+#include "bar.h"
+
+
+
+
+/* Width of the peak marker in pixels */
+#define MARKER_SIZE 2
+
+/* Minimum thickness of the bar in pixels */
+#define MIN_SIZE 4
+
+/* Opacity of the stacked segments that don't have an explicit color */
+static const gdouble SEGMENT_ALPHA[SYSTEMLOAD_BAR_MAX_SEGMENTS] = {
+    1.0, 0.65, 0.45, 0.3, 0.2, 0.14, 0.1, 0.07,
+};
+
+
+
+static void                 systemload_bar_unrealize              (GtkWidget        *widget);
+static gboolean             systemload_bar_draw                   (GtkWidget        *widget,
+                                                                   cairo_t          *cr);
+static void                 systemload_bar_get_preferred_width    (GtkWidget        *widget,
+                                                                   gint             *minimum,
+                                                                   gint             *natural);
+static void                 systemload_bar_get_preferred_height   (GtkWidget        *widget,
+                                                                   gint             *minimum,
+                                                                   gint             *natural);
+
+
+
+struct _SystemloadBarClass {
+  GtkWidgetClass   __parent__;
+};
+
+struct _SystemloadBar {
+  GtkWidget        __parent__;
+
+  GtkOrientation   orientation;
+
+  gdouble          fractions[SYSTEMLOAD_BAR_MAX_SEGMENTS];
+  guint            n_segments;
+  GdkRGBA          colors[SYSTEMLOAD_BAR_MAX_SEGMENTS - 1];
+  guint            n_colors;
+  gdouble          marker;
+
+  /*
+   * Pixels currently on the screen, measured along the bar from its start:
+   * the end of each segment (unused segments end where the last one ends)
+   * and the start of the marker (-1 if hidden). length is the size of the
+   * bar the pixels were computed for, or -1 if unknown.
+   */
+  gint             length;
+  gint             ends[SYSTEMLOAD_BAR_MAX_SEGMENTS];
+  gint             marker_start;
+
+  /* Span waiting to be invalidated at the next frame */
+  gint             dirty_start;
+  gint             dirty_end;
+  guint            tick_id;
+};
+
+
+
+G_DEFINE_TYPE (SystemloadBar, systemload_bar, GTK_TYPE_WIDGET)
+
+
+
+static void
+systemload_bar_class_init (SystemloadBarClass *klass)
+{
+  GtkWidgetClass *widget_class;
+
+  widget_class                       = GTK_WIDGET_CLASS (klass);
+  widget_class->unrealize            = systemload_bar_unrealize;
+  widget_class->draw                 = systemload_bar_draw;
+  widget_class->get_preferred_width  = systemload_bar_get_preferred_width;
+  widget_class->get_preferred_height = systemload_bar_get_preferred_height;
+
+  gtk_widget_class_set_css_name (widget_class, "systemloadbar");
+}
+
+
+
+static void
+systemload_bar_init (SystemloadBar *bar)
+{
+  gtk_widget_set_has_window (GTK_WIDGET (bar), FALSE);
+
+  bar->orientation = GTK_ORIENTATION_HORIZONTAL;
+  bar->n_segments = 1;
+  bar->marker = -1;
+  bar->length = -1;
+  bar->marker_start = -1;
+
+  gtk_style_context_add_class (gtk_widget_get_style_context (GTK_WIDGET (bar)), "horizontal");
+}
+
+
+
+static gint
+systemload_bar_get_length (SystemloadBar *bar)
+{
+  if (bar->orientation == GTK_ORIENTATION_HORIZONTAL)
+    return gtk_widget_get_allocated_width (GTK_WIDGET (bar));
+  else
+    return gtk_widget_get_allocated_height (GTK_WIDGET (bar));
+}
+
+
+
+static void
+systemload_bar_compute_pixels (const SystemloadBar *bar, gint length, gint *ends, gint *marker_start)
+{
+  gdouble sum = 0;
+
+  for (guint i = 0; i < SYSTEMLOAD_BAR_MAX_SEGMENTS; i++)
+    {
+      if (i < bar->n_segments)
+        sum += bar->fractions[i];
+      ends[i] = (gint) round (CLAMP (sum, 0.0, 1.0) * length);
+    }
+
+  if (bar->marker >= 0 && length >= MARKER_SIZE)
+    *marker_start = CLAMP ((gint) round (bar->marker * length) - MARKER_SIZE / 2, 0, length - MARKER_SIZE);
+  else
+    *marker_start = -1;
+}
+
+
+
+static gboolean
+systemload_bar_tick (GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data)
+{
+  SystemloadBar *bar = SYSTEMLOAD_BAR (widget);
+  gint width = gtk_widget_get_allocated_width (widget);
+  gint height = gtk_widget_get_allocated_height (widget);
+  gint span = bar->dirty_end - bar->dirty_start;
+
+  if (bar->orientation == GTK_ORIENTATION_HORIZONTAL)
+    gtk_widget_queue_draw_area (widget, bar->dirty_start, 0, span, height);
+  else
+    gtk_widget_queue_draw_area (widget, 0, height - bar->dirty_end, width, span);
+
+  bar->dirty_start = bar->dirty_end = 0;
+  bar->tick_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+
+
+static void
+systemload_bar_add_damage (SystemloadBar *bar, gint start, gint end)
+{
+  if (start >= end)
+    return;
+
+  if (bar->dirty_start >= bar->dirty_end)
+    {
+      bar->dirty_start = start;
+      bar->dirty_end = end;
+    }
+  else
+    {
+      bar->dirty_start = MIN (bar->dirty_start, start);
+      bar->dirty_end = MAX (bar->dirty_end, end);
+    }
+}
+
+
+
+/*
+ * Compares the pixels of the new values with the pixels on the screen and
+ * schedules the redraw of the span that changed. The span is invalidated
+ * from a frame clock tick, so that the invalidations of all bars (and of
+ * repeated updates of the same bar) are painted together in one frame.
+ */
+static void
+systemload_bar_update (SystemloadBar *bar)
+{
+  GtkWidget *widget = GTK_WIDGET (bar);
+  gint length = systemload_bar_get_length (bar);
+  gint ends[SYSTEMLOAD_BAR_MAX_SEGMENTS];
+  gint marker_start;
+
+  systemload_bar_compute_pixels (bar, length, ends, &marker_start);
+
+  if (length != bar->length)
+    {
+      bar->length = length;
+      memcpy (bar->ends, ends, sizeof (ends));
+      bar->marker_start = marker_start;
+      gtk_widget_queue_draw (widget);
+      return;
+    }
+
+  for (guint i = 0; i < SYSTEMLOAD_BAR_MAX_SEGMENTS; i++)
+    {
+      if (ends[i] != bar->ends[i])
+        systemload_bar_add_damage (bar, MIN (ends[i], bar->ends[i]), MAX (ends[i], bar->ends[i]));
+      bar->ends[i] = ends[i];
+    }
+
+  if (marker_start != bar->marker_start)
+    {
+      if (bar->marker_start >= 0)
+        systemload_bar_add_damage (bar, bar->marker_start, bar->marker_start + MARKER_SIZE);
+      if (marker_start >= 0)
+        systemload_bar_add_damage (bar, marker_start, marker_start + MARKER_SIZE);
+      bar->marker_start = marker_start;
+    }
+
+  /* Unrealized bars are painted completely once they are shown */
+  if (!gtk_widget_get_realized (widget))
+    {
+      bar->dirty_start = bar->dirty_end = 0;
+      return;
+    }
+
+  if (bar->dirty_start < bar->dirty_end && bar->tick_id == 0)
+    bar->tick_id = gtk_widget_add_tick_callback (widget, systemload_bar_tick, NULL, NULL);
+}
+
+
+
+static void
+systemload_bar_unrealize (GtkWidget *widget)
+{
+  SystemloadBar *bar = SYSTEMLOAD_BAR (widget);
+
+  if (bar->tick_id != 0)
+    {
+      gtk_widget_remove_tick_callback (widget, bar->tick_id);
+      bar->tick_id = 0;
+    }
+  bar->dirty_start = bar->dirty_end = 0;
+
+  GTK_WIDGET_CLASS (systemload_bar_parent_class)->unrealize (widget);
+}
+
+
+
+/* Fills the span [start, end) of the bar, measured from its start */
+static void
+systemload_bar_fill (SystemloadBar *bar, cairo_t *cr, gint width, gint height, gint start, gint end)
+{
+  if (bar->orientation == GTK_ORIENTATION_HORIZONTAL)
+    cairo_rectangle (cr, start, 0, end - start, height);
+  else
+    cairo_rectangle (cr, 0, height - end, width, end - start);
+  cairo_fill (cr);
+}
+
+
+
+static gboolean
+systemload_bar_draw (GtkWidget *widget, cairo_t *cr)
+{
+  SystemloadBar *bar = SYSTEMLOAD_BAR (widget);
+  GtkStyleContext *context = gtk_widget_get_style_context (widget);
+  gint width = gtk_widget_get_allocated_width (widget);
+  gint height = gtk_widget_get_allocated_height (widget);
+  GdkRGBA color;
+
+  gtk_render_background (context, cr, 0, 0, width, height);
+  gtk_render_frame (context, cr, 0, 0, width, height);
+
+  /* The allocation may have changed since the last update */
+  bar->length = systemload_bar_get_length (bar);
+  systemload_bar_compute_pixels (bar, bar->length, bar->ends, &bar->marker_start);
+
+  gtk_style_context_get_color (context, gtk_style_context_get_state (context), &color);
+
+  gint start = 0;
+  for (guint i = 0; i < bar->n_segments; i++)
+    {
+      gint end = bar->ends[i];
+      if (end > start)
+        {
+          if (i > 0 && i - 1 < bar->n_colors)
+            gdk_cairo_set_source_rgba (cr, &bar->colors[i - 1]);
+          else
+            cairo_set_source_rgba (cr, color.red, color.green, color.blue, color.alpha * SEGMENT_ALPHA[i]);
+          systemload_bar_fill (bar, cr, width, height, start, end);
+        }
+      start = end;
+    }
+
+  if (bar->marker_start >= 0)
+    {
+      gdk_cairo_set_source_rgba (cr, &color);
+      systemload_bar_fill (bar, cr, width, height, bar->marker_start, bar->marker_start + MARKER_SIZE);
+    }
+
+  return FALSE;
+}
+
+
+
+static void
+systemload_bar_get_preferred_width (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  *minimum = *natural = MIN_SIZE;
+}
+
+
+
+static void
+systemload_bar_get_preferred_height (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  *minimum = *natural = MIN_SIZE;
+}
+
+
+
+GtkWidget *
+systemload_bar_new (void)
+{
+  return GTK_WIDGET (g_object_new (TYPE_SYSTEMLOAD_BAR, NULL));
+}
+
+
+
+void
+systemload_bar_set_orientation (SystemloadBar *bar, GtkOrientation orientation)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_BAR (bar));
+
+  if (bar->orientation == orientation)
+    return;
+
+  GtkStyleContext *context = gtk_widget_get_style_context (GTK_WIDGET (bar));
+  gtk_style_context_remove_class (context, orientation == GTK_ORIENTATION_HORIZONTAL ? "vertical" : "horizontal");
+  gtk_style_context_add_class (context, orientation == GTK_ORIENTATION_HORIZONTAL ? "horizontal" : "vertical");
+
+  bar->orientation = orientation;
+  bar->length = -1;
+  systemload_bar_update (bar);
+}
+
+
+
+void
+systemload_bar_set_fraction (SystemloadBar *bar, gdouble fraction)
+{
+  systemload_bar_set_segments (bar, &fraction, 1);
+}
+
+
+
+void
+systemload_bar_set_segments (SystemloadBar *bar, const gdouble *fractions, guint n_fractions)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_BAR (bar));
+
+  n_fractions = MIN (n_fractions, SYSTEMLOAD_BAR_MAX_SEGMENTS);
+  for (guint i = 0; i < n_fractions; i++)
+    bar->fractions[i] = MAX (fractions[i], 0.0);
+  bar->n_segments = n_fractions;
+
+  systemload_bar_update (bar);
+}
+
+
+
+void
+systemload_bar_set_segment_colors (SystemloadBar *bar, const GdkRGBA *colors, guint n_colors)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_BAR (bar));
+
+  n_colors = MIN (n_colors, SYSTEMLOAD_BAR_MAX_SEGMENTS - 1);
+  if (n_colors == bar->n_colors && memcmp (colors, bar->colors, n_colors * sizeof (GdkRGBA)) == 0)
+    return;
+
+  memcpy (bar->colors, colors, n_colors * sizeof (GdkRGBA));
+  bar->n_colors = n_colors;
+  gtk_widget_queue_draw (GTK_WIDGET (bar));
+}
+
+
+
+void
+systemload_bar_set_marker (SystemloadBar *bar, gdouble fraction)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_BAR (bar));
+
+  bar->marker = MIN (fraction, 1.0);
+  systemload_bar_update (bar);
+}
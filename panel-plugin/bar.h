@@ -0,0 +1,83 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_BAR_H_
+#define _XFCE_SYSTEMLOAD_BAR_H_
+
+#include <gtk/gtk.h>
+
+/*
+ * A lightweight replacement of GtkProgressBar drawn with cairo.
+ *
+ * The bar is filled with the CSS color of the widget (CSS node name
+ * "systemloadbar") and the trough with its CSS background. It supports
+ * up to SYSTEMLOAD_BAR_MAX_SEGMENTS stacked segments and a peak marker.
+ * Updates that don't change any pixel are ignored, other updates
+ * invalidate only the pixel span that changed.
+ */
+
+#define SYSTEMLOAD_BAR_MAX_SEGMENTS 8
+
+typedef struct _SystemloadBarClass SystemloadBarClass;
+typedef struct _SystemloadBar      SystemloadBar;
+
+#define TYPE_SYSTEMLOAD_BAR             (systemload_bar_get_type ())
+#define SYSTEMLOAD_BAR(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), TYPE_SYSTEMLOAD_BAR, SystemloadBar))
+#define SYSTEMLOAD_BAR_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass),  TYPE_SYSTEMLOAD_BAR, SystemloadBarClass))
+#define IS_SYSTEMLOAD_BAR(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), TYPE_SYSTEMLOAD_BAR))
+#define IS_SYSTEMLOAD_BAR_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass),  TYPE_SYSTEMLOAD_BAR))
+#define SYSTEMLOAD_BAR_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj),  TYPE_SYSTEMLOAD_BAR, SystemloadBarClass))
+
+GType              systemload_bar_get_type            (void) G_GNUC_CONST;
+
+GtkWidget         *systemload_bar_new                 (void);
+
+/* GTK_ORIENTATION_VERTICAL fills the bar from the bottom, GTK_ORIENTATION_HORIZONTAL from the left */
+void               systemload_bar_set_orientation     (SystemloadBar        *bar,
+                                                       GtkOrientation        orientation);
+
+void               systemload_bar_set_fraction        (SystemloadBar        *bar,
+                                                       gdouble               fraction);
+
+/* Stacked segments, the sum of the fractions should not exceed 1 */
+void               systemload_bar_set_segments        (SystemloadBar        *bar,
+                                                       const gdouble        *fractions,
+                                                       guint                 n_fractions);
+
+/*
+ * Colors of the segments following the first one. Without explicit colors
+ * the segments use the CSS color with decreasing opacity.
+ */
+void               systemload_bar_set_segment_colors  (SystemloadBar        *bar,
+                                                       const GdkRGBA        *colors,
+                                                       guint                 n_colors);
+
+/* Peak marker, hidden if the fraction is negative */
+void               systemload_bar_set_marker          (SystemloadBar        *bar,
+                                                       gdouble               fraction);
+
+#endif /* _XFCE_SYSTEMLOAD_BAR_H_ */
@@ -39,6 +39,9 @@
 #include <glib/gi18n.h>
 #include <stdint.h>
 
+#include "procfs.h"
+#include "scan.h"
+
 #define PROC_STAT "/proc/stat"
 
 /* user, nice, system, interrupt(BSD specific), idle */
@@ -46,28 +49,198 @@ struct cpu_load_struct {
     gulong load[5];
 };
 
+/* Upper bound of the core numbers, protects against garbage */
+#define MAX_CORES 8192
+
+struct t_core_times {
+    gulong used, total;
+};
+
 static gulong oldtotal, oldused;
+static t_core_times *core_times;
+static guint8 *core_loads;
+static guint n_core_times;
 
-gulong read_cpuload()
+/*
+ * Parses the times following the label of a cpu line: user, nice, system,
+ * idle, iowait, irq, softirq, steal and guest time. Older kernels have
+ * fewer fields.
+ */
+bool
+parse_cpu_times (const gchar *p, const gchar *eol, gulong *used, gulong *total)
 {
-    FILE *fd = fopen(PROC_STAT, "r");
-    if (!fd) {
+    guint64 v[9] = {};
+    if (scan_numbers (p, eol, v, G_N_ELEMENTS (v)) < 4)
+        return false;
+
+    /* Don't count steal time. It is neither busy nor free tiime. */
+    *used = v[0] + v[1] + v[2] + v[5] + v[6] + v[8];
+    *total = *used + v[3] + v[4];
+    return true;
+}
+
+/*
+ * Computes the utilization of each core since the last call and returns
+ * the highest one, or -1 if unknown. The lines "cpu0", "cpu1", ... follow
+ * the first line, the lines after them (like the long "intr" line) are
+ * left to read_activity().
+ */
+static gint
+read_peak (const gchar *p, const gchar *end)
+{
+    gint peak = -1;
+
+    /* Offline cores don't have a line */
+    if (n_core_times != 0)
+        memset (core_loads, CPU_CORE_NO_DATA, n_core_times);
+
+    while (end - p > 3 && memcmp (p, "cpu", 3) == 0)
+    {
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *q = p + 3;
+        guint64 core;
+        gulong used, total;
+
+        if (scan_number (&q, eol, &core) && core < MAX_CORES && parse_cpu_times (q, eol, &used, &total))
+        {
+            if (core >= n_core_times)
+            {
+                core_times = g_renew (t_core_times, core_times, core + 1);
+                core_loads = g_renew (guint8, core_loads, core + 1);
+                memset (core_times + n_core_times, 0, (core + 1 - n_core_times) * sizeof (*core_times));
+                memset (core_loads + n_core_times, CPU_CORE_NO_DATA, core + 1 - n_core_times);
+                n_core_times = core + 1;
+            }
+
+            /* Cores that went offline and online again restart from zero */
+            t_core_times *c = &core_times[core];
+            if (c->total != 0 && total > c->total && used >= c->used)
+            {
+                gint load = MIN (100 * (used - c->used) / (total - c->total), 100);
+                core_loads[core] = load;
+                peak = MAX (peak, load);
+            }
+            c->used = used;
+            c->total = total;
+        }
+        p = eol + 1;
+    }
+
+    return peak;
+}
+
+/* Counters of /proc/stat, in the order of t_cpu_activity */
+static const gchar *const ACTIVITY_KEYS[] = {
+    "ctxt ",
+    "intr ",
+    "processes ",
+    "procs_running ",
+    "procs_blocked ",
+};
+
+static guint64 old_activity[3];
+static gint64 old_activity_time;
+
+/*
+ * Reads the lines following the first line. Only the first number of the
+ * "intr" line, the total, is needed, the rest of it is skipped by memchr().
+ */
+static void
+read_activity (const gchar *p, const gchar *end, t_cpu_activity *activity)
+{
+    const guint all = (1u << G_N_ELEMENTS (ACTIVITY_KEYS)) - 1;
+    guint64 values[G_N_ELEMENTS (ACTIVITY_KEYS)];
+    guint found = 0, n_cpus = 0;
+
+    while (p < end && found != all)
+    {
+        const gchar *eol = scan_line_end (p, end);
+        if (eol - p > 3 && memcmp (p, "cpu", 3) == 0)
+        {
+            n_cpus++;
+        }
+        else
+        {
+            for (guint i = 0; i < G_N_ELEMENTS (ACTIVITY_KEYS); i++)
+            {
+                const gsize key_length = strlen (ACTIVITY_KEYS[i]);
+                const gchar *q = p + key_length;
+                if ((gsize) (eol - p) > key_length && memcmp (p, ACTIVITY_KEYS[i], key_length) == 0)
+                {
+                    if (scan_number (&q, eol, &values[i]))
+                        found |= 1u << i;
+                    break;
+                }
+            }
+        }
+        p = eol + 1;
+    }
+
+    activity->valid = (found == all);
+    if (!activity->valid)
+        return;
+
+    /* Rates of ctxt, intr and processes */
+    gint64 now = g_get_monotonic_time ();
+    gdouble rates[G_N_ELEMENTS (old_activity)] = {};
+    for (guint i = 0; i < G_N_ELEMENTS (old_activity); i++)
+    {
+        if (old_activity_time != 0 && now > old_activity_time && values[i] >= old_activity[i])
+            rates[i] = (values[i] - old_activity[i]) * (gdouble) G_USEC_PER_SEC / (now - old_activity_time);
+        old_activity[i] = values[i];
+    }
+    old_activity_time = now;
+
+    activity->context_switches = rates[0];
+    activity->interrupts = rates[1];
+    activity->forks = rates[2];
+    activity->running = values[3];
+    activity->blocked = values[4];
+    activity->n_cpus = MAX (n_cpus, 1);
+}
+
+guint read_cpuload_cores(const guint8 **loads)
+{
+    *loads = core_loads;
+    return n_core_times;
+}
+
+void read_cpu_activity(t_cpu_activity *activity)
+{
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (PROC_STAT), &length);
+    activity->valid = false;
+    if (!contents)
+        return;
+
+    const gchar *end = contents + length;
+    read_activity (scan_line_end (contents, end) + 1, end, activity);
+}
+
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
+{
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (PROC_STAT), &length);
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+    if (!contents) {
         g_warning("%s", _("File /proc/stat not found!"));
         return 0;
     }
 
-    /* Don't count steal time. It is neither busy nor free tiime. */
-    unsigned long long int user, unice, usystem, idle, iowait, irq, softirq, guest;
-    int nb_read = fscanf (fd, "%*s %llu %llu %llu %llu %llu %llu %llu %*u %llu",
-                          &user, &unice, &usystem, &idle, &iowait, &irq, &softirq, &guest);
-    fclose(fd);
-    if (nb_read <= 4) iowait = 0;
-    if (nb_read <= 5) irq = 0;
-    if (nb_read <= 6) softirq = 0;
-    if (nb_read <= 7) guest = 0;
-
-    gulong used = user + unice + usystem + irq + softirq + guest;
-    gulong total = used + idle + iowait;
+    /* The first line is "cpu" followed by the times summed over all cores */
+    const gchar *end = contents + length;
+    const gchar *eol = scan_line_end (contents, end);
+    gulong used, total;
+    if (!parse_cpu_times (contents + strlen ("cpu"), eol, &used, &total))
+        return 0;
+
+    if (peak)
+        *peak = read_peak (eol + 1, end);
+    if (activity)
+        read_activity (eol + 1, end, activity);
 
     gulong cpu_used;
     if ((total - oldtotal) != 0)
@@ -101,12 +274,17 @@ struct cpu_load_struct {
 
 static gulong oldtotal, oldused;
 
-gulong read_cpuload()
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
 {
     gulong cpu_used, used, total;
     long cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
 
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+
     if (sysctlbyname("kern.cp_time", &cp_time, &len, NULL, 0) < 0) {
         g_warning("Cannot get kern.cp_time");
         return 0;
@@ -153,13 +331,18 @@ struct cpu_load_struct {
 
 static gulong oldtotal, oldused;
 
-gulong read_cpuload()
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
 {
     gulong cpu_used, used, total;
     static int mib[] = { CTL_KERN, KERN_CP_TIME };
     u_int64_t cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
 
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+
     if (sysctl(mib, 2, &cp_time, &len, NULL, 0) < 0) {
         g_warning("Cannot get kern.cp_time");
         return 0;
@@ -206,13 +389,18 @@ struct cpu_load_struct {
 
 static gulong oldtotal, oldused;
 
-gulong read_cpuload()
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
 {
     gulong cpu_used, used, total;
     static int mib[] = { CTL_KERN, KERN_CPTIME };
     long cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
 
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+
     if (sysctl(mib, 2, &cp_time, &len, NULL, 0) < 0) {
             g_warning("Cannot get kern.cp_time");
             return 0;
@@ -255,12 +443,17 @@ struct cpu_load_struct {
 
 static gulong oldtotal, oldused;
 
-gulong read_cpuload()
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
 {
     gulong cpu_used, used, total;
     host_cpu_load_info_data_t cpuload;
     mach_msg_type_number_t cpuload_count = HOST_CPU_LOAD_INFO_COUNT;
 
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+
     if (host_statistics(mach_host_self(), HOST_CPU_LOAD_INFO, (host_info_t)&cpuload, &cpuload_count) != KERN_SUCCESS) {
         g_warning("Cannot get host_statistics(HOST_CPU_LOAD_INFO)");
         return 0;
@@ -295,12 +488,17 @@ void init_stats()
     kc = kstat_open();
 }
 
-gulong read_cpuload()
+gulong read_cpuload(gint *peak, t_cpu_activity *activity)
 {
     gulong cpu_used, used, total;
     kstat_t *ksp;
     kstat_named_t *knp;
 
+    if (peak)
+        *peak = -1;
+    if (activity)
+        activity->valid = false;
+
     if (!kc)
     {
        init_stats();
@@ -342,3 +540,16 @@ gulong read_cpuload()
 #else
 #error "Your platform is not yet supported"
 #endif
+
+#if !defined(__linux__) && !defined(__FreeBSD_kernel__)
+guint read_cpuload_cores(const guint8 **loads)
+{
+    *loads = NULL;
+    return 0;
+}
+
+void read_cpu_activity(t_cpu_activity *activity)
+{
+    activity->valid = false;
+}
+#endif
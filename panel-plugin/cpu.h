@@ -31,6 +31,44 @@
 
 #include <glib.h>
 
-gulong read_cpuload();
+/* Scheduler activity from the lines of /proc/stat following the cpu lines */
+struct t_cpu_activity {
+    bool    valid;
+    gdouble context_switches;   /* Per second */
+    gdouble interrupts;         /* Per second */
+    gdouble forks;              /* Per second */
+    guint   running;            /* Runnable tasks */
+    guint   blocked;            /* Tasks in uninterruptible sleep (D state) */
+    guint   n_cpus;             /* Online CPUs */
+};
+
+/*
+ * Returns the utilization of all cores in percent. If peak isn't NULL, it
+ * is set to the utilization of the busiest core, or to -1 if unknown. If
+ * activity isn't NULL, it is filled from the same read, the rates are
+ * computed since the previous call with activity.
+ */
+gulong read_cpuload(gint *peak, t_cpu_activity *activity);
+
+/*
+ * Fills activity like read_cpuload() without advancing the snapshots of
+ * the load, for reads of the activity alone at its own interval.
+ */
+void read_cpu_activity(t_cpu_activity *activity);
+
+/* Value of cores without data, like offline cores */
+#define CPU_CORE_NO_DATA 0xff
+
+/*
+ * Utilization of each core in percent, or CPU_CORE_NO_DATA, as computed by
+ * the last read_cpuload() call with peak. Returns the number of cores.
+ */
+guint read_cpuload_cores(const guint8 **loads);
+
+/*
+ * Busy and total ticks of a "cpu" line of /proc/stat, p points past the
+ * label. For monitors that keep their own per-core snapshot.
+ */
+bool parse_cpu_times(const gchar *p, const gchar *eol, gulong *used, gulong *total);
 
 #endif /* _XFCE_SYSTEMLOAD_CPU_H_ */
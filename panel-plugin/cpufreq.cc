@@ -0,0 +1,209 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "cpufreq.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+#define SYSFS_CPU "/sys/devices/system/cpu"
+
+/* Same bound as the CPUs of /proc/stat, protects against garbage */
+#define MAX_CPU 8191
+
+struct t_cpu_state {
+    bool    online;
+    bool    throttle;           /* First thread of its core, which owns the throttle counter */
+    bool    throttle_valid;     /* prev_throttle was read since the CPU came online */
+    gint    cur_freq_file;      /* procfs files while online, -1 if read on demand */
+    gint    throttle_file;
+    guint64 max_freq;           /* kHz, 0 if the CPU has no cpufreq */
+    guint64 prev_throttle;
+};
+
+static t_cpu_state *cpus;
+static guint        n_cpus;
+static gint         online_file = -1;
+static gchar       *online;     /* Contents of SYSFS_CPU/online */
+
+/* Registers the file if the procfs registry has room for it, returns -1 otherwise */
+static gint
+open_cpu_file (guint cpu, const gchar *name)
+{
+    gchar path[128];
+    if (procfs_budget () == 0)
+        return -1;
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/%s", cpu, name);
+    return procfs_open (path);
+}
+
+/* Reads the registered file, or the file itself past the budget of the registry */
+static bool
+read_cpu_number (guint cpu, gint file, const gchar *name, guint64 *value)
+{
+    if (file >= 0)
+    {
+        gsize length;
+        const gchar *contents = procfs_read (file, &length);
+        return contents && scan_number (&contents, contents + length, value);
+    }
+
+    gchar path[128];
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/%s", cpu, name);
+    return procfs_read_number (path, value);
+}
+
+/*
+ * Looks up the maximum frequency and the throttle counter of the CPUs
+ * that went online since the last call. Their sysfs attributes were
+ * created again, the counters start over.
+ */
+static void
+update_online (const gchar *contents, gsize length)
+{
+    bool *now_online = g_new0 (bool, n_cpus);
+    scan_ranges (contents, contents + length, [&now_online](guint64 first, guint64 last) {
+        last = MIN (last, MAX_CPU);
+        if (last >= n_cpus)
+        {
+            cpus = g_renew (t_cpu_state, cpus, last + 1);
+            memset (cpus + n_cpus, 0, (last + 1 - n_cpus) * sizeof (*cpus));
+            now_online = g_renew (bool, now_online, last + 1);
+            memset (now_online + n_cpus, 0, (last + 1 - n_cpus) * sizeof (*now_online));
+            n_cpus = last + 1;
+        }
+        for (guint64 cpu = first; cpu <= last; cpu++)
+            now_online[cpu] = true;
+    });
+
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        t_cpu_state *c = &cpus[cpu];
+        if (c->online == now_online[cpu])
+            continue;
+
+        /* The files of an offline CPU are gone, open ones would fail to read */
+        if (c->online)
+        {
+            procfs_close (c->cur_freq_file);
+            procfs_close (c->throttle_file);
+        }
+        memset (c, 0, sizeof (*c));
+        c->cur_freq_file = c->throttle_file = -1;
+        c->online = now_online[cpu];
+        if (!c->online)
+            continue;
+
+        guint64 first_sibling;
+        if (!read_cpu_number (cpu, -1, "cpufreq/cpuinfo_max_freq", &c->max_freq))
+            c->max_freq = 0;
+        /* SMT siblings share the counter of their core, the list starts with the lowest sibling */
+        c->throttle = read_cpu_number (cpu, -1, "topology/thread_siblings_list", &first_sibling) && first_sibling == cpu;
+
+        if (c->max_freq != 0)
+            c->cur_freq_file = open_cpu_file (cpu, "cpufreq/scaling_cur_freq");
+        if (c->throttle)
+            c->throttle_file = open_cpu_file (cpu, "thermal_throttle/core_throttle_count");
+    }
+    g_free (now_online);
+}
+
+gint
+read_cpufreq (t_cpufreq *freq)
+{
+    gsize length;
+
+    /* The CPUs are looked up again only when the list of online CPUs changes */
+    if (online_file < 0)
+        online_file = procfs_open (SYSFS_CPU "/online");
+    const gchar *contents = procfs_read (online_file, &length);
+    if (contents && (online == NULL || strlen (online) != length || memcmp (online, contents, length) != 0))
+    {
+        g_free (online);
+        online = g_strndup (contents, length);
+        update_online (online, length);
+    }
+
+    guint64 sum = 0, sum_khz = 0;
+    memset (freq, 0, sizeof (*freq));
+    freq->min = G_MAXUINT;
+
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        t_cpu_state *c = &cpus[cpu];
+        guint64 value;
+
+        if (!c->online)
+            continue;
+
+        if (c->max_freq != 0 && read_cpu_number (cpu, c->cur_freq_file, "cpufreq/scaling_cur_freq", &value))
+        {
+            guint percent = MIN (value * 100 / c->max_freq, 100);
+            sum += percent;
+            sum_khz += value;
+            if (percent < freq->min)
+            {
+                freq->min = percent;
+                freq->min_khz = value;
+            }
+            freq->n_cpus++;
+        }
+
+        if (c->throttle && read_cpu_number (cpu, c->throttle_file, "thermal_throttle/core_throttle_count", &value))
+        {
+            if (c->throttle_valid && value >= c->prev_throttle)
+                freq->throttle_events += value - c->prev_throttle;
+            c->prev_throttle = value;
+            c->throttle_valid = true;
+        }
+    }
+
+    if (freq->n_cpus == 0)
+    {
+        freq->min = 0;
+        return -1;
+    }
+
+    freq->avg = (sum + freq->n_cpus / 2) / freq->n_cpus;
+    freq->avg_khz = sum_khz / freq->n_cpus;
+    return 0;
+}
+
+#else
+
+gint
+read_cpufreq (t_cpufreq *freq)
+{
+    memset (freq, 0, sizeof (*freq));
+    return -1;
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_CPUFREQ_H_
+#define _XFCE_SYSTEMLOAD_CPUFREQ_H_
+
+#include <glib.h>
+
+/*
+ * Current clock of the CPUs relative to their maximum, from scaling_cur_freq
+ * and cpuinfo_max_freq in /sys/devices/system/cpu/cpuN/cpufreq, and the
+ * thermal throttling events counted by thermal_throttle/core_throttle_count.
+ * The files of each online CPU stay open in the procfs registry as far as
+ * its budget allows, the others are read on demand. A CPU coming online
+ * again gets its files opened again and starts a new throttle count.
+ */
+
+struct t_cpufreq {
+    guint   n_cpus;             /* CPUs with a known frequency */
+    guint   avg;                /* Percent of the maximum frequency */
+    guint   min;                /* Percent of the maximum frequency, of the slowest CPU */
+    guint64 avg_khz;
+    guint64 min_khz;
+    guint64 throttle_events;    /* Since the previous read, summed over the physical cores */
+};
+
+/* Returns 0 on success, -1 if no CPU reports its frequency */
+gint    read_cpufreq    (t_cpufreq *freq);
+
+#endif /* _XFCE_SYSTEMLOAD_CPUFREQ_H_ */
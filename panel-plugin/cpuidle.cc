@@ -0,0 +1,281 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "cpuidle.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+#define SYSFS_CPU "/sys/devices/system/cpu"
+
+/* Same bound as the CPUs of /proc/stat, protects against garbage */
+#define MAX_CPU 8191
+
+struct t_cpu_state {
+    bool    online;
+    bool    valid;                              /* prev_time and prev_usage were read since the CPU came online */
+    guint   n_states;
+    guint   package;                            /* Index into package_ids */
+    gint    time_files[CPUIDLE_MAX_STATES];     /* procfs files while online, -1 if read on demand */
+    gint    usage_files[CPUIDLE_MAX_STATES];
+    guint64 prev_time[CPUIDLE_MAX_STATES];      /* Microseconds */
+    guint64 prev_usage[CPUIDLE_MAX_STATES];
+};
+
+static t_cpu_state *cpus;
+static guint        n_cpus;
+static gint         online_file = -1;
+static gchar       *online;     /* Contents of SYSFS_CPU/online */
+static gchar        state_names[CPUIDLE_MAX_STATES][16];
+static guint        n_states;
+static guint        package_ids[CPUIDLE_MAX_PACKAGES];
+static guint        n_packages;
+static gint64       prev_time;
+
+/* Registers the file if the procfs registry has room for it, returns -1 otherwise */
+static gint
+open_state_file (guint cpu, guint state, const gchar *name)
+{
+    gchar path[128];
+    if (procfs_budget () == 0)
+        return -1;
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/cpuidle/state%u/%s", cpu, state, name);
+    return procfs_open (path);
+}
+
+/* Reads the registered file, or the file itself past the budget of the registry */
+static bool
+read_state_number (guint cpu, guint state, gint file, const gchar *name, guint64 *value)
+{
+    if (file >= 0)
+    {
+        gsize length;
+        const gchar *contents = procfs_read (file, &length);
+        return contents && scan_number (&contents, contents + length, value);
+    }
+
+    gchar path[128];
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/cpuidle/state%u/%s", cpu, state, name);
+    return procfs_read_number (path, value);
+}
+
+static void
+read_state_name (guint cpu, guint state)
+{
+    gchar path[128], *name;
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/cpuidle/state%u/name", cpu, state);
+    if (g_file_get_contents (path, &name, NULL, NULL))
+    {
+        g_strlcpy (state_names[state], g_strstrip (name), sizeof (state_names[state]));
+        g_free (name);
+    }
+    else
+        g_snprintf (state_names[state], sizeof (state_names[state]), "state%u", state);
+}
+
+static void
+discover_cpu (guint cpu)
+{
+    t_cpu_state *c = &cpus[cpu];
+    gchar path[128];
+    guint64 package_id, value;
+
+    for (c->n_states = 0; c->n_states < CPUIDLE_MAX_STATES; c->n_states++)
+    {
+        const guint state = c->n_states;
+        if (!read_state_number (cpu, state, -1, "time", &value))
+            break;
+        if (state >= n_states)
+        {
+            read_state_name (cpu, state);
+            n_states = state + 1;
+        }
+        c->time_files[state] = open_state_file (cpu, state, "time");
+        c->usage_files[state] = open_state_file (cpu, state, "usage");
+    }
+
+    g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/topology/physical_package_id", cpu);
+    if (!procfs_read_number (path, &package_id))
+        package_id = 0;
+    for (c->package = 0; c->package < n_packages; c->package++)
+        if (package_ids[c->package] == package_id)
+            break;
+    /* The CPUs of further packages are counted in the last one */
+    if (c->package == n_packages)
+    {
+        if (n_packages < CPUIDLE_MAX_PACKAGES)
+            package_ids[n_packages++] = package_id;
+        else
+            c->package = n_packages - 1;
+    }
+}
+
+/*
+ * Looks up the states and the package of the CPUs that went online since
+ * the last call. Their sysfs attributes were created again, the counters
+ * start over.
+ */
+static void
+update_online (const gchar *contents, gsize length)
+{
+    bool *now_online = g_new0 (bool, n_cpus);
+    scan_ranges (contents, contents + length, [&now_online](guint64 first, guint64 last) {
+        last = MIN (last, MAX_CPU);
+        if (last >= n_cpus)
+        {
+            cpus = g_renew (t_cpu_state, cpus, last + 1);
+            memset (cpus + n_cpus, 0, (last + 1 - n_cpus) * sizeof (*cpus));
+            now_online = g_renew (bool, now_online, last + 1);
+            memset (now_online + n_cpus, 0, (last + 1 - n_cpus) * sizeof (*now_online));
+            n_cpus = last + 1;
+        }
+        for (guint64 cpu = first; cpu <= last; cpu++)
+            now_online[cpu] = true;
+    });
+
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        t_cpu_state *c = &cpus[cpu];
+        if (c->online == now_online[cpu])
+            continue;
+
+        /* The files of an offline CPU are gone, open ones would fail to read */
+        for (guint state = 0; c->online && state < c->n_states; state++)
+        {
+            procfs_close (c->time_files[state]);
+            procfs_close (c->usage_files[state]);
+        }
+        memset (c, 0, sizeof (*c));
+        c->online = now_online[cpu];
+        if (c->online)
+            discover_cpu (cpu);
+    }
+    g_free (now_online);
+}
+
+gint
+read_cpuidle (t_cpuidle *idle)
+{
+    gsize length;
+
+    /* The states are looked up again only when the list of online CPUs changes */
+    if (online_file < 0)
+        online_file = procfs_open (SYSFS_CPU "/online");
+    const gchar *contents = procfs_read (online_file, &length);
+    if (contents && (online == NULL || strlen (online) != length || memcmp (online, contents, length) != 0))
+    {
+        g_free (online);
+        online = g_strndup (contents, length);
+        update_online (online, length);
+    }
+
+    gint64 now = g_get_monotonic_time ();
+    const gdouble seconds = prev_time != 0 ? (now - prev_time) / (gdouble) G_USEC_PER_SEC : 0;
+    prev_time = now;
+
+    memset (idle, 0, sizeof (*idle));
+    if (n_states == 0)
+        return -1;
+
+    idle->n_states = n_states;
+    memcpy (idle->names, state_names, sizeof (idle->names));
+    idle->n_packages = n_packages;
+    for (guint i = 0; i < n_packages; i++)
+        idle->packages[i].id = package_ids[i];
+
+    /*
+     * CPUs with a full interval. A CPU that just came online has no delta
+     * yet, a CPU with a state that failed to read adds none of its states.
+     */
+    guint counted[CPUIDLE_MAX_PACKAGES] = { 0 };
+
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        t_cpu_state *c = &cpus[cpu];
+        t_cpuidle_package *package = &idle->packages[c->package];
+        guint64 time[CPUIDLE_MAX_STATES], usage[CPUIDLE_MAX_STATES];
+        if (!c->online || c->n_states == 0)
+            continue;
+        package->n_cpus++;
+
+        guint state = 0;
+        while (state < c->n_states &&
+               read_state_number (cpu, state, c->time_files[state], "time", &time[state]) &&
+               read_state_number (cpu, state, c->usage_files[state], "usage", &usage[state]))
+            state++;
+        if (state < c->n_states)
+        {
+            c->valid = false;
+            continue;
+        }
+
+        bool complete = seconds > 0 && c->valid;
+        for (state = 0; state < c->n_states && complete; state++)
+            complete = time[state] >= c->prev_time[state] && usage[state] >= c->prev_usage[state];
+
+        for (state = 0; state < c->n_states; state++)
+        {
+            if (complete)
+            {
+                package->residency[state] += (time[state] - c->prev_time[state]) / (seconds * G_USEC_PER_SEC);
+                package->entries[state] += (usage[state] - c->prev_usage[state]) / seconds;
+            }
+            c->prev_time[state] = time[state];
+            c->prev_usage[state] = usage[state];
+        }
+        c->valid = true;
+        if (complete)
+            counted[c->package]++;
+    }
+
+    /* Averages over the CPUs of each package */
+    for (guint i = 0; i < n_packages; i++)
+    {
+        t_cpuidle_package *package = &idle->packages[i];
+        for (guint state = 0; state < n_states && counted[i] != 0; state++)
+        {
+            package->residency[state] = MIN (package->residency[state] / counted[i], 1);
+            package->entries[state] /= counted[i];
+        }
+    }
+
+    return 0;
+}
+
+#else
+
+gint
+read_cpuidle (t_cpuidle *idle)
+{
+    return -1;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_CPUIDLE_H_
+#define _XFCE_SYSTEMLOAD_CPUIDLE_H_
+
+#include <glib.h>
+
+/*
+ * Residency of the CPU idle states (C-states), from the cumulative time and
+ * usage counters in /sys/devices/system/cpu/cpuN/cpuidle/stateM. The files
+ * stay open in the procfs registry as far as its budget allows, the others
+ * are read on demand. The states of a CPU are looked up again only when it
+ * goes online.
+ */
+
+/* CPUIDLE_STATE_MAX of the kernel */
+#define CPUIDLE_MAX_STATES 10
+#define CPUIDLE_MAX_PACKAGES 8
+
+struct t_cpuidle_package {
+    guint   id;
+    guint   n_cpus;
+    gdouble residency[CPUIDLE_MAX_STATES];  /* Share of the interval spent in each state, 0 to 1 */
+    gdouble entries[CPUIDLE_MAX_STATES];    /* Per second and CPU */
+};
+
+struct t_cpuidle {
+    guint   n_states;
+    gchar   names[CPUIDLE_MAX_STATES][16];  /* Like "POLL", "C1E" or "C6" */
+    guint   n_packages;
+    t_cpuidle_package packages[CPUIDLE_MAX_PACKAGES];
+};
+
+/* Returns 0 on success, -1 without cpuidle. The shares are 0 after the first read. */
+gint    read_cpuidle    (t_cpuidle *idle);
+
+#endif /* _XFCE_SYSTEMLOAD_CPUIDLE_H_ */
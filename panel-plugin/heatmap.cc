@@ -0,0 +1,416 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "heatmap.h"
+
+
+
+
+/* Pixels per cell including the gap to the next cell */
+#define CELL_SIZE 4
+
+/* Number of distinct colors, a cell is repainted only if its color changes */
+#define N_LEVELS 10
+
+/* Level of cells without a value, and value of painted[] for cells not painted yet */
+#define LEVEL_NONE    0xfe
+#define LEVEL_UNKNOWN 0xff
+
+
+
+static void                 systemload_heatmap_finalize              (GObject          *object);
+static void                 systemload_heatmap_unrealize             (GtkWidget        *widget);
+static void                 systemload_heatmap_style_updated         (GtkWidget        *widget);
+static gboolean             systemload_heatmap_draw                  (GtkWidget        *widget,
+                                                                      cairo_t          *cr);
+static void                 systemload_heatmap_get_preferred_width   (GtkWidget        *widget,
+                                                                      gint             *minimum,
+                                                                      gint             *natural);
+static void                 systemload_heatmap_get_preferred_height  (GtkWidget        *widget,
+                                                                      gint             *minimum,
+                                                                      gint             *natural);
+
+
+
+struct _SystemloadHeatmapClass {
+  GtkWidgetClass   __parent__;
+};
+
+struct _SystemloadHeatmap {
+  GtkWidget        __parent__;
+
+  /* The grid has "across" cells across the panel and as many columns (or rows) along it as needed */
+  GtkOrientation   orientation;
+  guint            across;
+  guint            along;
+
+  guint            n_cells;
+  guint8          *levels;
+  guint8          *painted;
+
+  /* Cached cells, NULL if it must be painted from scratch */
+  cairo_surface_t *surface;
+  GdkRGBA          color;
+
+  /* Area waiting to be invalidated at the next frame */
+  GdkRectangle     dirty;
+  guint            tick_id;
+};
+
+
+
+G_DEFINE_TYPE (SystemloadHeatmap, systemload_heatmap, GTK_TYPE_WIDGET)
+
+
+
+static void
+systemload_heatmap_class_init (SystemloadHeatmapClass *klass)
+{
+  GObjectClass   *gobject_class;
+  GtkWidgetClass *widget_class;
+
+  gobject_class = G_OBJECT_CLASS (klass);
+  gobject_class->finalize = systemload_heatmap_finalize;
+
+  widget_class                       = GTK_WIDGET_CLASS (klass);
+  widget_class->unrealize            = systemload_heatmap_unrealize;
+  widget_class->style_updated        = systemload_heatmap_style_updated;
+  widget_class->draw                 = systemload_heatmap_draw;
+  widget_class->get_preferred_width  = systemload_heatmap_get_preferred_width;
+  widget_class->get_preferred_height = systemload_heatmap_get_preferred_height;
+
+  gtk_widget_class_set_css_name (widget_class, "systemloadheatmap");
+}
+
+
+
+static void
+systemload_heatmap_init (SystemloadHeatmap *heatmap)
+{
+  gtk_widget_set_has_window (GTK_WIDGET (heatmap), FALSE);
+
+  heatmap->orientation = GTK_ORIENTATION_HORIZONTAL;
+  heatmap->across = 1;
+}
+
+
+
+static void
+systemload_heatmap_finalize (GObject *object)
+{
+  SystemloadHeatmap *heatmap = SYSTEMLOAD_HEATMAP (object);
+
+  g_free (heatmap->levels);
+  g_free (heatmap->painted);
+  if (heatmap->surface)
+    cairo_surface_destroy (heatmap->surface);
+
+  G_OBJECT_CLASS (systemload_heatmap_parent_class)->finalize (object);
+}
+
+
+
+static void
+systemload_heatmap_drop_surface (SystemloadHeatmap *heatmap)
+{
+  if (heatmap->surface)
+    {
+      cairo_surface_destroy (heatmap->surface);
+      heatmap->surface = NULL;
+    }
+  if (heatmap->n_cells != 0)
+    memset (heatmap->painted, LEVEL_UNKNOWN, heatmap->n_cells);
+}
+
+
+
+static void
+systemload_heatmap_cell_rect (const SystemloadHeatmap *heatmap, guint cell, GdkRectangle *rect)
+{
+  gint along = (cell / heatmap->across) * CELL_SIZE;
+  gint across = (cell % heatmap->across) * CELL_SIZE;
+
+  rect->x = (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL) ? along : across;
+  rect->y = (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL) ? across : along;
+  rect->width = rect->height = CELL_SIZE - 1;
+}
+
+
+
+static void
+systemload_heatmap_paint_cell (SystemloadHeatmap *heatmap, cairo_t *cr, guint cell, GdkRectangle *rect)
+{
+  guint8 level = heatmap->levels[cell];
+  const GdkRGBA *c = &heatmap->color;
+
+  systemload_heatmap_cell_rect (heatmap, cell, rect);
+  if (level == LEVEL_NONE)
+    cairo_set_source_rgba (cr, 0, 0, 0, 0);
+  else
+    cairo_set_source_rgba (cr, c->red, c->green, c->blue,
+                           c->alpha * (0.15 + 0.85 * level / (N_LEVELS - 1)));
+  cairo_rectangle (cr, rect->x, rect->y, rect->width, rect->height);
+  cairo_fill (cr);
+
+  heatmap->painted[cell] = level;
+}
+
+
+
+/* Creates the cached surface with all cells, needs a realized widget */
+static void
+systemload_heatmap_ensure_surface (SystemloadHeatmap *heatmap)
+{
+  GtkWidget *widget = GTK_WIDGET (heatmap);
+  GtkStyleContext *context = gtk_widget_get_style_context (widget);
+  GdkRectangle rect;
+  gint width = heatmap->along * CELL_SIZE;
+  gint height = heatmap->across * CELL_SIZE;
+
+  if (heatmap->surface || heatmap->n_cells == 0)
+    return;
+
+  if (heatmap->orientation == GTK_ORIENTATION_VERTICAL)
+    {
+      gint tmp = width;
+      width = height;
+      height = tmp;
+    }
+
+  gtk_style_context_get_color (context, gtk_style_context_get_state (context), &heatmap->color);
+
+  heatmap->surface = gdk_window_create_similar_image_surface (gtk_widget_get_window (widget),
+                                                              CAIRO_FORMAT_ARGB32, width, height,
+                                                              gtk_widget_get_scale_factor (widget));
+  cairo_t *cr = cairo_create (heatmap->surface);
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  for (guint i = 0; i < heatmap->n_cells; i++)
+    systemload_heatmap_paint_cell (heatmap, cr, i, &rect);
+  cairo_destroy (cr);
+}
+
+
+
+static gboolean
+systemload_heatmap_tick (GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data)
+{
+  SystemloadHeatmap *heatmap = SYSTEMLOAD_HEATMAP (widget);
+
+  gtk_widget_queue_draw_area (widget, heatmap->dirty.x, heatmap->dirty.y,
+                              heatmap->dirty.width, heatmap->dirty.height);
+  heatmap->dirty.width = heatmap->dirty.height = 0;
+  heatmap->tick_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+
+
+/*
+ * Repaints the cells whose color changed into the cached surface and
+ * invalidates their bounding box at the next frame, like SystemloadBar.
+ */
+static void
+systemload_heatmap_update (SystemloadHeatmap *heatmap)
+{
+  GtkWidget *widget = GTK_WIDGET (heatmap);
+  cairo_t *cr = NULL;
+  GdkRectangle rect;
+
+  if (!heatmap->surface)
+    {
+      gtk_widget_queue_draw (widget);
+      return;
+    }
+
+  for (guint i = 0; i < heatmap->n_cells; i++)
+    {
+      if (heatmap->levels[i] == heatmap->painted[i])
+        continue;
+
+      if (cr == NULL)
+        {
+          cr = cairo_create (heatmap->surface);
+          cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+        }
+      systemload_heatmap_paint_cell (heatmap, cr, i, &rect);
+
+      if (heatmap->dirty.width == 0)
+        heatmap->dirty = rect;
+      else
+        gdk_rectangle_union (&heatmap->dirty, &rect, &heatmap->dirty);
+    }
+
+  if (cr == NULL)
+    return;
+  cairo_destroy (cr);
+
+  if (heatmap->tick_id == 0)
+    heatmap->tick_id = gtk_widget_add_tick_callback (widget, systemload_heatmap_tick, NULL, NULL);
+}
+
+
+
+static void
+systemload_heatmap_unrealize (GtkWidget *widget)
+{
+  SystemloadHeatmap *heatmap = SYSTEMLOAD_HEATMAP (widget);
+
+  if (heatmap->tick_id != 0)
+    {
+      gtk_widget_remove_tick_callback (widget, heatmap->tick_id);
+      heatmap->tick_id = 0;
+    }
+  heatmap->dirty.width = heatmap->dirty.height = 0;
+
+  /* The surface is similar to the window of the widget */
+  systemload_heatmap_drop_surface (heatmap);
+
+  GTK_WIDGET_CLASS (systemload_heatmap_parent_class)->unrealize (widget);
+}
+
+
+
+static void
+systemload_heatmap_style_updated (GtkWidget *widget)
+{
+  GTK_WIDGET_CLASS (systemload_heatmap_parent_class)->style_updated (widget);
+
+  /* The color may have changed */
+  systemload_heatmap_drop_surface (SYSTEMLOAD_HEATMAP (widget));
+  gtk_widget_queue_draw (widget);
+}
+
+
+
+static gboolean
+systemload_heatmap_draw (GtkWidget *widget, cairo_t *cr)
+{
+  SystemloadHeatmap *heatmap = SYSTEMLOAD_HEATMAP (widget);
+
+  systemload_heatmap_ensure_surface (heatmap);
+  if (heatmap->surface)
+    {
+      cairo_set_source_surface (cr, heatmap->surface, 0, 0);
+      cairo_paint (cr);
+    }
+
+  return FALSE;
+}
+
+
+
+static void
+systemload_heatmap_get_size (SystemloadHeatmap *heatmap, GtkOrientation orientation, gint *minimum, gint *natural)
+{
+  guint cells = (orientation == heatmap->orientation) ? heatmap->along : heatmap->across;
+  *minimum = *natural = MAX (cells, 1u) * CELL_SIZE;
+}
+
+
+
+static void
+systemload_heatmap_get_preferred_width (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  systemload_heatmap_get_size (SYSTEMLOAD_HEATMAP (widget), GTK_ORIENTATION_HORIZONTAL, minimum, natural);
+}
+
+
+
+static void
+systemload_heatmap_get_preferred_height (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  systemload_heatmap_get_size (SYSTEMLOAD_HEATMAP (widget), GTK_ORIENTATION_VERTICAL, minimum, natural);
+}
+
+
+
+/* Recomputes the shape of the grid, returns true if it changed */
+static bool
+systemload_heatmap_layout (SystemloadHeatmap *heatmap, GtkOrientation orientation, guint across)
+{
+  across = MAX (across, 1u);
+  guint along = (heatmap->n_cells + across - 1) / across;
+
+  if (orientation == heatmap->orientation && across == heatmap->across && along == heatmap->along)
+    return false;
+
+  heatmap->orientation = orientation;
+  heatmap->across = across;
+  heatmap->along = along;
+  systemload_heatmap_drop_surface (heatmap);
+  gtk_widget_queue_resize (GTK_WIDGET (heatmap));
+  return true;
+}
+
+
+
+GtkWidget *
+systemload_heatmap_new (void)
+{
+  return GTK_WIDGET (g_object_new (TYPE_SYSTEMLOAD_HEATMAP, NULL));
+}
+
+
+
+void
+systemload_heatmap_set_panel_size (SystemloadHeatmap *heatmap, GtkOrientation orientation, gint size)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_HEATMAP (heatmap));
+
+  systemload_heatmap_layout (heatmap, orientation, MAX (size, 0) / CELL_SIZE);
+}
+
+
+
+void
+systemload_heatmap_set_values (SystemloadHeatmap *heatmap, const guint8 *values, guint n_values)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_HEATMAP (heatmap));
+
+  if (n_values != heatmap->n_cells)
+    {
+      heatmap->levels = (guint8*) g_realloc (heatmap->levels, n_values);
+      heatmap->painted = (guint8*) g_realloc (heatmap->painted, n_values);
+      heatmap->n_cells = n_values;
+      memset (heatmap->painted, LEVEL_UNKNOWN, n_values);
+      systemload_heatmap_layout (heatmap, heatmap->orientation, heatmap->across);
+      systemload_heatmap_drop_surface (heatmap);
+    }
+
+  for (guint i = 0; i < n_values; i++)
+    {
+      if (values[i] == SYSTEMLOAD_HEATMAP_NO_VALUE)
+        heatmap->levels[i] = LEVEL_NONE;
+      else
+        heatmap->levels[i] = (MIN (values[i], 100) * (N_LEVELS - 1) + 50) / 100;
+    }
+
+  systemload_heatmap_update (heatmap);
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_HEATMAP_H_
+#define _XFCE_SYSTEMLOAD_HEATMAP_H_
+
+#include <gtk/gtk.h>
+
+/*
+ * A compact grid of cells, one per core, for hosts with too many cores to
+ * show a bar for each. Cells are filled with the CSS color of the widget
+ * (CSS node name "systemloadheatmap"), more opaque for higher values.
+ *
+ * The cells are painted into a cached image surface and a cell is only
+ * repainted when its quantized color changes; drawing the widget copies
+ * the surface.
+ */
+
+/* Value of cells without data, like offline cores */
+#define SYSTEMLOAD_HEATMAP_NO_VALUE 0xff
+
+typedef struct _SystemloadHeatmapClass SystemloadHeatmapClass;
+typedef struct _SystemloadHeatmap      SystemloadHeatmap;
+
+#define TYPE_SYSTEMLOAD_HEATMAP             (systemload_heatmap_get_type ())
+#define SYSTEMLOAD_HEATMAP(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), TYPE_SYSTEMLOAD_HEATMAP, SystemloadHeatmap))
+#define SYSTEMLOAD_HEATMAP_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass),  TYPE_SYSTEMLOAD_HEATMAP, SystemloadHeatmapClass))
+#define IS_SYSTEMLOAD_HEATMAP(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), TYPE_SYSTEMLOAD_HEATMAP))
+#define IS_SYSTEMLOAD_HEATMAP_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass),  TYPE_SYSTEMLOAD_HEATMAP))
+#define SYSTEMLOAD_HEATMAP_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj),  TYPE_SYSTEMLOAD_HEATMAP, SystemloadHeatmapClass))
+
+GType              systemload_heatmap_get_type         (void) G_GNUC_CONST;
+
+GtkWidget         *systemload_heatmap_new              (void);
+
+/*
+ * Orientation of the panel and its size in pixels. The grid fills the
+ * size of the panel across and grows along the panel as needed.
+ */
+void               systemload_heatmap_set_panel_size   (SystemloadHeatmap    *heatmap,
+                                                        GtkOrientation        orientation,
+                                                        gint                  size);
+
+/* Values in percent, or SYSTEMLOAD_HEATMAP_NO_VALUE */
+void               systemload_heatmap_set_values       (SystemloadHeatmap    *heatmap,
+                                                        const guint8         *values,
+                                                        guint                 n_values);
+
+#endif /* _XFCE_SYSTEMLOAD_HEATMAP_H_ */
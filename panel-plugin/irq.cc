@@ -0,0 +1,367 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib/gi18n.h>
+
+#include "irq.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+/* Rows are matched across reads by the label before the colon, like "24" or "NET_RX" */
+#define KEY_SIZE 16
+
+/* Same bound as the CPUs of /proc/stat, protects against garbage */
+#define MAX_CPU 8191
+
+struct t_irq_table {
+    const gchar  *path;
+    bool          softirq;
+    guint         n_columns;
+    guint         n_rows;
+    guint         max_columns;            /* Capacity of the arrays, counts has a stride of max_columns */
+    guint         max_rows;
+    guint        *column_cpu;             /* CPU of each column */
+    guint64      *values;                 /* Counters of the row being parsed */
+    gchar        *keys;                   /* KEY_SIZE bytes per row */
+    guint64      *counts;                 /* Counters of the previous read */
+};
+
+/* A busy row, pointing into the contents of the file until the names are formatted */
+struct t_candidate {
+    const t_irq_table *table;
+    const gchar       *key;
+    gsize              key_length;
+    const gchar       *description;
+    const gchar       *description_end;
+    guint64            count;
+};
+
+static t_irq_table tables[] = {
+    { "/proc/interrupts", false },
+    { "/proc/softirqs", true },
+};
+
+/* Interrupts and softirqs of each CPU since the previous read, indexed by CPU */
+static guint64 *cpu_delta;
+static guint    n_cpu_delta;
+static gint64   prev_time;
+static gint     benchmark_rounds = -1;   /* -1 = not initialized */
+
+/* Reads the CPUs of the header line, forgets all rows if they changed (CPU hotplug) */
+static void
+parse_header (t_irq_table *table, const gchar *p, const gchar *eol)
+{
+    guint64 cpu;
+    guint n = 0;
+    bool same = true;
+
+    for (const gchar *q = p; scan_number (&q, eol, &cpu); n++)
+        if (n >= table->n_columns || table->column_cpu[n] != MIN (cpu, MAX_CPU))
+            same = false;
+    if (same && n == table->n_columns)
+        return;
+
+    if (n > table->max_columns)
+    {
+        table->max_columns = n;
+        table->column_cpu = g_renew (guint, table->column_cpu, n);
+        table->values = g_renew (guint64, table->values, n);
+        g_free (table->counts);
+        table->counts = g_new (guint64, (gsize) table->max_rows * n);
+    }
+    table->n_columns = n;
+    table->n_rows = 0;
+
+    n = 0;
+    for (const gchar *q = p; n < table->n_columns && scan_number (&q, eol, &cpu); n++)
+    {
+        cpu = MIN (cpu, MAX_CPU);
+        table->column_cpu[n] = cpu;
+        if (cpu >= n_cpu_delta)
+        {
+            cpu_delta = g_renew (guint64, cpu_delta, cpu + 1);
+            memset (cpu_delta + n_cpu_delta, 0, (cpu + 1 - n_cpu_delta) * sizeof (*cpu_delta));
+            n_cpu_delta = cpu + 1;
+        }
+    }
+}
+
+/* Keeps the IRQ_TOP_SOURCES busiest rows, sorted by count */
+static void
+add_candidate (t_candidate *top, guint *n_top, const t_candidate *c)
+{
+    guint i = *n_top;
+    if (i == IRQ_TOP_SOURCES)
+    {
+        if (c->count <= top[i - 1].count)
+            return;
+        i--;
+    }
+    else
+        (*n_top)++;
+
+    for (; i > 0 && top[i - 1].count < c->count; i--)
+        top[i] = top[i - 1];
+    top[i] = *c;
+}
+
+/*
+ * Parses the rows following the header, adds their increments to cpu_delta
+ * and returns the sum of the increments. A row whose label differs from the
+ * previous read (a source appeared or went away) starts over from 0.
+ */
+static guint64
+parse_rows (t_irq_table *table, const gchar *p, const gchar *end, t_candidate *top, guint *n_top)
+{
+    guint64 total = 0;
+    guint row = 0;
+
+    for (; p < end; p++)
+    {
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *colon = (const gchar*) memchr (p, ':', eol - p);
+        if (!colon)
+        {
+            p = eol;
+            continue;
+        }
+
+        while (p < colon && *p == ' ')
+            p++;
+        const gsize key_length = MIN ((gsize) (colon - p), KEY_SIZE - 1);
+
+        if (G_UNLIKELY (row == table->max_rows))
+        {
+            table->max_rows = MAX (2 * table->max_rows, 32);
+            table->keys = g_renew (gchar, table->keys, (gsize) table->max_rows * KEY_SIZE);
+            table->counts = g_renew (guint64, table->counts, (gsize) table->max_rows * table->max_columns);
+        }
+
+        gchar *key = table->keys + (gsize) row * KEY_SIZE;
+        const bool known = row < table->n_rows && strncmp (key, p, key_length) == 0 && key[key_length] == '\0';
+        if (!known)
+        {
+            memcpy (key, p, key_length);
+            key[key_length] = '\0';
+        }
+
+        /* Stop after the counters, the description may contain digits */
+        const gchar *q = colon + 1;
+        guint n = 0;
+        while (n < table->n_columns && scan_number (&q, eol, &table->values[n]))
+            n++;
+
+        /* Rows with fewer counters than CPUs are totals like ERR and MIS */
+        if (n == table->n_columns)
+        {
+            guint64 *counts = table->counts + (gsize) row * table->max_columns;
+            guint64 sum = 0;
+            for (guint c = 0; c < n; c++)
+            {
+                if (known && table->values[c] >= counts[c])
+                {
+                    guint64 delta = table->values[c] - counts[c];
+                    cpu_delta[table->column_cpu[c]] += delta;
+                    sum += delta;
+                }
+                counts[c] = table->values[c];
+            }
+
+            if (sum != 0)
+            {
+                t_candidate c = { table, p, key_length, q, eol, sum };
+                add_candidate (top, n_top, &c);
+                total += sum;
+            }
+        }
+
+        row++;
+        p = eol;
+    }
+
+    table->n_rows = row;
+    return total;
+}
+
+static guint64
+parse_table (t_irq_table *table, const gchar *contents, gsize length, t_candidate *top, guint *n_top)
+{
+    const gchar *end = contents + length;
+    const gchar *eol = scan_line_end (contents, end);
+
+    parse_header (table, contents, eol);
+    if (table->n_columns == 0)
+        return 0;
+    return parse_rows (table, eol, end, top, n_top);
+}
+
+static void
+format_source (gchar *name, gsize size, const t_candidate *c)
+{
+    const gchar *d = c->description, *e = c->description_end;
+    while (d < e && g_ascii_isspace (*d))
+        d++;
+    while (e > d && g_ascii_isspace (e[-1]))
+        e--;
+
+    if (c->table->softirq)
+        g_snprintf (name, size, _("%.*s softirq"), (gint) c->key_length, c->key);
+    else if (g_ascii_isdigit (c->key[0]))
+    {
+        /* Numbered interrupts end with the device, like "IO-APIC 2-edge timer" */
+        const gchar *device = e;
+        while (device > d && device[-1] != ' ')
+            device--;
+        g_snprintf (name, size, _("IRQ %.*s %.*s"), (gint) c->key_length, c->key, (gint) (e - device), device);
+    }
+    else if (d < e)
+        /* Like "Local timer interrupts" of LOC */
+        g_snprintf (name, size, "%.*s", (gint) (e - d), d);
+    else
+        g_snprintf (name, size, "%.*s", (gint) c->key_length, c->key);
+}
+
+static void
+run_benchmark (const gchar *const *contents, const gsize *lengths)
+{
+    const guint rounds = benchmark_rounds;
+    t_candidate top[IRQ_TOP_SOURCES];
+    guint n_top = 0, n_rows = 0;
+    gsize bytes = 0;
+
+    /* The contents are unchanged, the rows are known and all increments are 0 */
+    gint64 start = g_get_monotonic_time ();
+    for (guint r = 0; r < rounds; r++)
+        for (guint i = 0; i < G_N_ELEMENTS (tables); i++)
+            if (contents[i])
+                parse_table (&tables[i], contents[i], lengths[i], top, &n_top);
+    gint64 time = MAX (g_get_monotonic_time () - start, 1);
+
+    for (guint i = 0; i < G_N_ELEMENTS (tables); i++)
+        if (contents[i])
+        {
+            n_rows += tables[i].n_rows;
+            bytes += lengths[i];
+        }
+
+    g_message ("irq parser benchmark, %u rows, %u CPUs, %" G_GSIZE_FORMAT " bytes, %u rounds: "
+               "%.1f \302\265s per round, %.0f MB/s",
+               n_rows, tables[0].n_columns, bytes, rounds,
+               (gdouble) time / rounds, (gdouble) bytes * rounds / time);
+}
+
+gint
+read_irqs (t_irq_stats *stats)
+{
+    const gchar *contents[G_N_ELEMENTS (tables)];
+    gsize lengths[G_N_ELEMENTS (tables)];
+    guint64 totals[G_N_ELEMENTS (tables)] = { 0 };
+    t_candidate top[IRQ_TOP_SOURCES];
+    guint n_top = 0;
+
+    if (n_cpu_delta != 0)
+        memset (cpu_delta, 0, n_cpu_delta * sizeof (*cpu_delta));
+
+    for (guint i = 0; i < G_N_ELEMENTS (tables); i++)
+    {
+        contents[i] = procfs_read (procfs_open (tables[i].path), &lengths[i]);
+        /* Kernels without softirq accounting have only /proc/interrupts */
+        if (contents[i])
+            totals[i] = parse_table (&tables[i], contents[i], lengths[i], top, &n_top);
+        else if (i == 0)
+        {
+            g_warning ("Cannot read '%s'", tables[i].path);
+            return -1;
+        }
+    }
+
+    gint64 now = g_get_monotonic_time ();
+    const gdouble seconds = prev_time != 0 ? (now - prev_time) / (gdouble) G_USEC_PER_SEC : 0;
+    prev_time = now;
+
+    /* The columns of /proc/interrupts are the online CPUs, /proc/softirqs has all possible CPUs */
+    const t_irq_table *online = &tables[0];
+    guint64 sum = 0, max = 0;
+    stats->n_cpus = online->n_columns;
+    stats->hottest_cpu = 0;
+    for (guint c = 0; c < online->n_columns; c++)
+    {
+        guint64 delta = cpu_delta[online->column_cpu[c]];
+        sum += delta;
+        if (delta > max || c == 0)
+        {
+            max = delta;
+            stats->hottest_cpu = online->column_cpu[c];
+        }
+    }
+
+    stats->imbalance = sum != 0 ? (gdouble) max * online->n_columns / sum : 1;
+    if (seconds > 0)
+    {
+        stats->irq_rate = totals[0] / seconds;
+        stats->softirq_rate = totals[1] / seconds;
+        stats->hottest_rate = max / seconds;
+        stats->n_top = n_top;
+        for (guint i = 0; i < n_top; i++)
+        {
+            format_source (stats->top[i].name, sizeof (stats->top[i].name), &top[i]);
+            stats->top[i].rate = top[i].count / seconds;
+        }
+    }
+    else
+    {
+        stats->irq_rate = stats->softirq_rate = stats->hottest_rate = 0;
+        stats->n_top = 0;
+    }
+
+    if (G_UNLIKELY (benchmark_rounds < 0))
+    {
+        const gchar *env = g_getenv ("SYSTEMLOAD_IRQ_BENCHMARK");
+        benchmark_rounds = env ? atoi (env) : 0;
+        if (benchmark_rounds > 0)
+            run_benchmark (contents, lengths);
+        benchmark_rounds = 0;
+    }
+
+    return 0;
+}
+
+#else
+
+gint
+read_irqs (t_irq_stats *stats)
+{
+    return -1;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_IRQ_H_
+#define _XFCE_SYSTEMLOAD_IRQ_H_
+
+#include <glib.h>
+
+/*
+ * Distribution of the hardware interrupts and softirqs over the CPUs, read
+ * from /proc/interrupts and /proc/softirqs. Both files hold a counter per
+ * source and CPU and grow with the number of CPUs, on large machines they
+ * are hundreds of kilobytes. The parser keeps the counters of the previous
+ * read in arrays that are only reallocated when sources or CPUs appear,
+ * an update doesn't allocate any memory.
+ *
+ * Setting SYSTEMLOAD_IRQ_BENCHMARK to a number of rounds times the parser
+ * on the contents of the first update and reports via g_message().
+ */
+
+#define IRQ_TOP_SOURCES 5
+
+struct t_irq_source {
+    gchar   name[48];
+    gdouble rate;           /* Per second, all CPUs */
+};
+
+struct t_irq_stats {
+    guint   n_cpus;         /* Online CPUs */
+    gdouble irq_rate;       /* Hardware interrupts per second, all CPUs */
+    gdouble softirq_rate;   /* Softirqs per second, all CPUs */
+    gdouble imbalance;      /* Rate of the hottest CPU divided by the mean, 1 if balanced */
+    guint   hottest_cpu;
+    gdouble hottest_rate;   /* Interrupts and softirqs per second of the hottest CPU */
+    t_irq_source top[IRQ_TOP_SOURCES];   /* Busiest sources of both files, by rate */
+    guint   n_top;
+};
+
+/* Returns 0 on success, the rates are 0 after the first read */
+gint    read_irqs   (t_irq_stats *stats);
+
+#endif /* _XFCE_SYSTEMLOAD_IRQ_H_ */
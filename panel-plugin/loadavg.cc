@@ -0,0 +1,98 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "loadavg.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+static guint
+count_online_cpus ()
+{
+    gsize length;
+    guint n = 0;
+    const gchar *contents = procfs_read (procfs_open ("/sys/devices/system/cpu/online"), &length);
+
+    if (contents)
+        scan_ranges (contents, contents + length, [&n](guint64 first, guint64 last) {
+            n += last - first + 1;
+        });
+    return n;
+}
+
+gint
+read_loadavg (t_loadavg *loadavg)
+{
+    const gchar *filepath = "/proc/loadavg";
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (filepath), &length);
+    if (!contents)
+    {
+        g_warning ("Cannot read '%s'", filepath);
+        return -1;
+    }
+
+    /*
+     * Looks like "0.52 0.58 0.59 1/467 12345", the kernel always prints two
+     * decimals so each average is parsed as two numbers.
+     */
+    guint64 v[8];
+    if (scan_numbers (contents, contents + length, v, G_N_ELEMENTS (v)) != G_N_ELEMENTS (v))
+        return -1;
+
+    for (guint i = 0; i < 3; i++)
+        loadavg->load[i] = v[2 * i] + v[2 * i + 1] / 100.0;
+    loadavg->running = v[6];
+    loadavg->total = v[7];
+
+    loadavg->n_cpus = count_online_cpus ();
+    if (loadavg->n_cpus == 0)
+        loadavg->n_cpus = MAX (sysconf (_SC_NPROCESSORS_ONLN), 1);
+
+    return 0;
+}
+
+#else
+
+gint
+read_loadavg (t_loadavg *loadavg)
+{
+    if (getloadavg (loadavg->load, 3) != 3)
+        return -1;
+
+    loadavg->n_cpus = MAX (sysconf (_SC_NPROCESSORS_ONLN), 1);
+    loadavg->running = loadavg->total = 0;
+    return 0;
+}
+
+#endif
@@ -41,9 +41,8 @@
 #include <stdio.h>
 #include <string.h>
 
-
-#define MEMINFOBUFSIZE (2 * 1024)
-static char MemInfoBuf[MEMINFOBUFSIZE];
+#include "procfs.h"
+#include "scan.h"
 
 static unsigned long MTotal = 0;
 static unsigned long MFree = 0;
@@ -54,66 +53,110 @@ static unsigned long MUsed = 0;
 static unsigned long STotal = 0;
 static unsigned long SFree = 0;
 static unsigned long SUsed = 0;
+static unsigned long MAnon = 0;
+static unsigned long MShmem = 0;
+static unsigned long MSReclaimable = 0;
+static unsigned long MSUnreclaim = 0;
+static unsigned long MKernelStack = 0;
+static unsigned long MPageTables = 0;
+static unsigned long MDirty = 0;
+static unsigned long MWriteback = 0;
+static bool composition_valid = false;
+static t_mem_composition MemComposition;
+
+struct t_meminfo_field {
+    const char    *name;
+    unsigned long *value;
+};
+
+static const t_meminfo_field MEMINFO_FIELDS[] = {
+    { "MemTotal",     &MTotal },
+    { "MemFree",      &MFree },
+    { "Buffers",      &MBuffers },
+    { "Cached",       &MCached },
+    { "SwapTotal",    &STotal },
+    { "SwapFree",     &SFree },
+    { "MemAvailable", &MAvail },
+    { "AnonPages",    &MAnon },
+    { "Shmem",        &MShmem },
+    { "SReclaimable", &MSReclaimable },
+    { "SUnreclaim",   &MSUnreclaim },
+    { "KernelStack",  &MKernelStack },
+    { "PageTables",   &MPageTables },
+    { "Dirty",        &MDirty },
+    { "Writeback",    &MWriteback },
+};
+
+/* Bits of the fields in found, MemAvailable and the composition are optional */
+#define MEMINFO_REQUIRED    0x3fu
+#define MEMINFO_AVAILABLE   0x40u
+#define MEMINFO_COMPOSITION 0x7f80u
 
 gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
-    char *b_MTotal, *b_MFree, *b_MBuffers, *b_MCached, *b_MAvail, *b_STotal, *b_SFree;
-
     const char *filepath = "/proc/meminfo";
-    int fd;
-    if ((fd = open(filepath, O_RDONLY)) < 0)
-    {
-        g_warning ("Cannot open '%s'", filepath);
-        return -1;
-    }
-    ssize_t n = read(fd, MemInfoBuf, MEMINFOBUFSIZE - 1);
-    close(fd);
-    if (n < 0)
+    gsize length;
+    const char *MemInfoBuf = procfs_read (procfs_open (filepath), &length);
+    if (!MemInfoBuf)
     {
         g_warning ("Cannot read '%s'", filepath);
         return -1;
     }
-    if (n == MEMINFOBUFSIZE - 1)
+
+    /* Lines look like "MemTotal:       16303012 kB" */
+    guint found = 0;
+    const char *end = MemInfoBuf + length;
+    for (const char *p = MemInfoBuf; p < end; )
     {
-        g_warning ("Internal buffer too small to read '%s'", filepath);
-        return -1;
+        const char *eol = scan_line_end(p, end);
+        const char *colon = (const char *) memchr(p, ':', eol - p);
+        if (colon)
+        {
+            const gsize key_length = colon - p;
+            for (guint i = 0; i < G_N_ELEMENTS(MEMINFO_FIELDS); i++)
+            {
+                const t_meminfo_field *field = &MEMINFO_FIELDS[i];
+                guint64 value;
+                if (key_length == strlen(field->name) && memcmp(p, field->name, key_length) == 0)
+                {
+                    if (scan_number(&colon, eol, &value))
+                    {
+                        *field->value = value;
+                        found |= 1u << i;
+                    }
+                    break;
+                }
+            }
+        }
+        p = eol + 1;
     }
-
-    MemInfoBuf[n] = '\0';
-
-    b_MTotal = strstr(MemInfoBuf, "MemTotal");
-    if (!b_MTotal || !sscanf(b_MTotal + strlen("MemTotal"), ": %lu", &MTotal))
-        return -1;
-
-    b_MFree = strstr(MemInfoBuf, "MemFree");
-    if (!b_MFree || !sscanf(b_MFree + strlen("MemFree"), ": %lu", &MFree))
-        return -1;
-
-    b_MBuffers = strstr(MemInfoBuf, "Buffers");
-    if (!b_MBuffers || !sscanf(b_MBuffers + strlen("Buffers"), ": %lu", &MBuffers))
+    if ((found & MEMINFO_REQUIRED) != MEMINFO_REQUIRED)
         return -1;
 
-    b_MCached = strstr(MemInfoBuf, "Cached");
-    if (!b_MCached || !sscanf(b_MCached + strlen("Cached"), ": %lu", &MCached))
-        return -1;
+    /* Before MemAvailable drops the buffers and cache below */
+    composition_valid = (found & MEMINFO_COMPOSITION) == MEMINFO_COMPOSITION;
+    if (composition_valid)
+    {
+        MemComposition.total = MTotal;
+        MemComposition.anon = MAnon;
+        MemComposition.shmem = MShmem;
+        MemComposition.kernel = MKernelStack + MPageTables;
+        MemComposition.slab_unreclaimable = MSUnreclaim;
+        MemComposition.slab_reclaimable = MSReclaimable;
+        MemComposition.dirty = MDirty + MWriteback;
+        /* Cached includes the shmem and the dirty pages */
+        glong cache = (glong) (MCached + MBuffers) - (glong) (MShmem + MDirty + MWriteback);
+        MemComposition.page_cache = MAX (cache, 0);
+    }
 
     /* In Linux 3.14+, use MemAvailable instead */
-    b_MAvail = strstr(MemInfoBuf, "MemAvailable");
-    if (b_MAvail && sscanf(b_MAvail + strlen("MemAvailable"), ": %lu", &MAvail))
+    if (found & MEMINFO_AVAILABLE)
     {
         MFree = MAvail;
         MBuffers = 0;
         MCached = 0;
     }
 
-    b_STotal = strstr(MemInfoBuf, "SwapTotal");
-    if (!b_STotal || !sscanf(b_STotal + strlen("SwapTotal"), ": %lu", &STotal))
-        return -1;
-
-    b_SFree = strstr(MemInfoBuf, "SwapFree");
-    if (!b_SFree || !sscanf(b_SFree + strlen("SwapFree"), ": %lu", &SFree))
-        return -1;
-
     MFree += MCached + MBuffers;
     MUsed = MTotal - MFree;
     SUsed = STotal - SFree;
@@ -132,6 +175,14 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
     return 0;
 }
 
+bool read_memswap_composition(t_mem_composition *composition)
+{
+    if (!composition_valid)
+        return false;
+    *composition = MemComposition;
+    return true;
+}
+
 #elif defined(__FreeBSD__) || defined(__DragonFly__)
 /*
  * This is inspired by /usr/src/usr.bin/top/machine.c 
@@ -617,3 +668,10 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
 #else
 #error "Your platform is not yet supported"
 #endif
+
+#if !defined(__linux__) && !defined(__FreeBSD_kernel__)
+bool read_memswap_composition(t_mem_composition *composition)
+{
+    return false;
+}
+#endif
@@ -33,4 +33,19 @@
 
 gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU);
 
+/* Disjoint parts of the memory in KiB, from the same read of /proc/meminfo */
+struct t_mem_composition {
+    gulong total;
+    gulong anon;                /* Anonymous memory of processes */
+    gulong shmem;               /* tmpfs and shared anonymous memory */
+    gulong kernel;              /* Kernel stacks and page tables */
+    gulong slab_unreclaimable;
+    gulong slab_reclaimable;
+    gulong dirty;               /* Dirty and under writeback */
+    gulong page_cache;          /* Clean page cache and buffers */
+};
+
+/* Returns the composition from the last read_memswap(), false if the platform doesn't report it */
+bool read_memswap_composition(t_mem_composition *composition);
+
 #endif /* _XFCE_SYSTEMLOAD_MEMSWAP_H_ */
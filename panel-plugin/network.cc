@@ -29,6 +29,8 @@
 #include <string.h>
 #include <glib.h>
 #include "network.h"
+#include "procfs.h"
+#include "scan.h"
 
 #ifdef HAVE_LIBGTOP
 /* Defined by obsoleted AC_HEADER_TIME macro, wanted by libgtop */
@@ -66,40 +68,32 @@ read_netload_libgtop (gulong *bytes)
 #endif
 
 static const char *const PROC_NET_DEV = "/proc/net/dev";
-static const char *const REGEX_PATTERN = ".*:\\s*(\\d+)\\s*\\d+\\s*\\d+\\s*\\d+\\s*\\d+\\s*\\d+\\s*\\d+\\s*\\d+\\s*(\\d+)\\s*";
 
+/*
+ * Lines of the interfaces look like "  eth0: 1234 56 0 0 0 0 0 0 7890 ...",
+ * the first number is the count of received bytes and the ninth the count
+ * of transmitted bytes. The header lines don't contain a colon.
+ */
 static gint
 read_netload_proc (gulong *bytes)
 {
-    gchar *contents;
-    GError *error;
-    GRegex *regex;
-    GMatchInfo *match_info;
-
-    if (g_file_get_contents (PROC_NET_DEV, &contents, NULL, &error) == FALSE)
-    {
-        g_error ("Failed to read contents of %s: %s.", PROC_NET_DEV, error->message);
-        g_error_free (error);
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (PROC_NET_DEV), &length);
+    if (contents == NULL)
         return -1;
-    }
 
+    const gchar *end = contents + length;
     *bytes = 0;
-    regex = g_regex_new (REGEX_PATTERN, (GRegexCompileFlags) 0, (GRegexMatchFlags) 0, NULL);
-    g_regex_match (regex, contents, (GRegexMatchFlags) 0, &match_info);
-    while (g_match_info_matches (match_info))
+    for (const gchar *p = contents; p < end; )
     {
-        gchar *rx = g_match_info_fetch (match_info, 1);
-        gchar *tx = g_match_info_fetch (match_info, 2);
-        *bytes += g_ascii_strtoll (rx, NULL, 10) + g_ascii_strtoll (tx, NULL, 10);
-        g_free (rx);
-        g_free (tx);
-        g_match_info_next (match_info, NULL);
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *colon = (const gchar*) memchr (p, ':', eol - p);
+        guint64 v[9];
+        if (colon && scan_numbers (colon + 1, eol, v, G_N_ELEMENTS (v)) == G_N_ELEMENTS (v))
+            *bytes += v[0] + v[8];
+        p = eol + 1;
     }
 
-    g_match_info_free (match_info);
-    g_regex_unref (regex);
-    g_free (contents);
-
     return 0;
 }
 
@@ -0,0 +1,277 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "cpu.h"
+#include "numa.h"
+
+#ifdef __linux__
+
+#include <stdio.h>
+
+#include "procfs.h"
+#include "scan.h"
+
+#define SYSFS_NODE "/sys/devices/system/node"
+#define PROC_STAT "/proc/stat"
+
+/* Upper bound of the CPU numbers, protects against garbage */
+#define MAX_CPU 8191
+
+struct t_cpu_times {
+    gulong used, total;
+};
+
+/* Node of each CPU, -1 for CPUs not listed by any node */
+static gint8   *cpu_node;
+static guint    n_cpu_node;
+static guint    node_ids[NUMA_MAX_NODES];
+static guint    n_nodes;
+static gchar   *online;                     /* Contents of SYSFS_NODE/online */
+
+/* Times of each CPU at the previous read, not shared with the CPU monitor */
+static t_cpu_times *cpu_times;
+static guint    n_cpu_times;
+
+/* Counters of the previous read, to compute the rates */
+static guint64  prev_miss[NUMA_MAX_NODES];
+static guint64  prev_foreign[NUMA_MAX_NODES];
+static gint64   prev_time;
+
+/* Reads the nodes and the CPUs of each node, after boot or when nodes come online */
+static void
+load_nodes (const gchar *contents, gsize length)
+{
+    n_nodes = 0;
+    scan_ranges (contents, contents + length, [](guint64 first, guint64 last) {
+        for (guint64 id = first; id <= last && n_nodes < NUMA_MAX_NODES; id++)
+            node_ids[n_nodes++] = id;
+    });
+
+    if (n_cpu_node != 0)
+        memset (cpu_node, -1, n_cpu_node);
+
+    for (guint node = 0; node < n_nodes; node++)
+    {
+        gchar path[128];
+        gsize list_length;
+        g_snprintf (path, sizeof (path), SYSFS_NODE "/node%u/cpulist", node_ids[node]);
+        const gchar *list = procfs_read (procfs_open (path), &list_length);
+        if (!list)
+            continue;
+
+        scan_ranges (list, list + list_length, [node](guint64 first, guint64 last) {
+            last = MIN (last, MAX_CPU);
+            if (last >= n_cpu_node)
+            {
+                cpu_node = g_renew (gint8, cpu_node, last + 1);
+                memset (cpu_node + n_cpu_node, -1, last + 1 - n_cpu_node);
+                n_cpu_node = last + 1;
+            }
+            for (guint64 cpu = first; cpu <= last; cpu++)
+                cpu_node[cpu] = node;
+        });
+    }
+
+    memset (prev_miss, 0, sizeof (prev_miss));
+    memset (prev_foreign, 0, sizeof (prev_foreign));
+    prev_time = 0;
+}
+
+/* Lines look like "Node 0 MemTotal:       32768 kB", returns false if MemTotal is missing */
+static bool
+read_node_meminfo (guint id, t_numa_node *node)
+{
+    static const gchar *const FIELDS[] = { "MemTotal", "MemFree", "FilePages", "SReclaimable" };
+    guint64 values[G_N_ELEMENTS (FIELDS)] = {};
+    gchar path[128];
+    gsize length;
+
+    g_snprintf (path, sizeof (path), SYSFS_NODE "/node%u/meminfo", id);
+    const gchar *contents = procfs_read (procfs_open (path), &length);
+    if (!contents)
+        return false;
+
+    const gchar *end = contents + length;
+    for (const gchar *p = contents; p < end; )
+    {
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *colon = (const gchar *) memchr (p, ':', eol - p);
+        if (colon)
+        {
+            const gchar *key = colon;
+            while (key > p && key[-1] != ' ')
+                key--;
+            for (guint i = 0; i < G_N_ELEMENTS (FIELDS); i++)
+            {
+                if ((gsize) (colon - key) == strlen (FIELDS[i]) && memcmp (key, FIELDS[i], colon - key) == 0)
+                {
+                    scan_number (&colon, eol, &values[i]);
+                    break;
+                }
+            }
+        }
+        p = eol + 1;
+    }
+
+    if (values[0] == 0)
+        return false;
+
+    guint64 available = values[1] + values[2] + values[3];
+    node->mem_total = values[0];
+    node->mem_used = available < values[0] ? values[0] - available : 0;
+    return true;
+}
+
+/* Lines look like "numa_miss 1234" */
+static void
+read_node_numastat (guint id, guint64 *miss, guint64 *foreign)
+{
+    gchar path[128];
+    gsize length;
+
+    *miss = *foreign = 0;
+    g_snprintf (path, sizeof (path), SYSFS_NODE "/node%u/numastat", id);
+    const gchar *contents = procfs_read (procfs_open (path), &length);
+    if (!contents)
+        return;
+
+    const gchar *end = contents + length;
+    for (const gchar *p = contents; p < end; )
+    {
+        const gchar *eol = scan_line_end (p, end);
+        if (eol - p > 10 && memcmp (p, "numa_miss ", 10) == 0)
+            scan_number (&p, eol, miss);
+        else if (eol - p > 13 && memcmp (p, "numa_foreign ", 13) == 0)
+            scan_number (&p, eol, foreign);
+        p = eol + 1;
+    }
+}
+
+/*
+ * Adds the busy and total ticks of the CPUs of each node since the last
+ * call. CPUs that went offline and online again restart from zero.
+ */
+static void
+read_node_times (guint64 *used, guint64 *total)
+{
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (PROC_STAT), &length);
+    if (!contents)
+        return;
+
+    /* The per-CPU lines "cpu0", "cpu1", ... follow the line with the sums */
+    const gchar *end = contents + length;
+    const gchar *p = scan_line_end (contents, end) + 1;
+    while (end - p > 3 && memcmp (p, "cpu", 3) == 0)
+    {
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *q = p + 3;
+        guint64 cpu;
+        gulong cpu_used, cpu_total;
+
+        if (scan_number (&q, eol, &cpu) && cpu <= MAX_CPU && parse_cpu_times (q, eol, &cpu_used, &cpu_total))
+        {
+            if (cpu >= n_cpu_times)
+            {
+                cpu_times = g_renew (t_cpu_times, cpu_times, cpu + 1);
+                memset (cpu_times + n_cpu_times, 0, (cpu + 1 - n_cpu_times) * sizeof (*cpu_times));
+                n_cpu_times = cpu + 1;
+            }
+
+            t_cpu_times *c = &cpu_times[cpu];
+            if (cpu < n_cpu_node && cpu_node[cpu] >= 0 && c->total != 0 && cpu_total > c->total && cpu_used >= c->used)
+            {
+                used[cpu_node[cpu]] += cpu_used - c->used;
+                total[cpu_node[cpu]] += cpu_total - c->total;
+            }
+            c->used = cpu_used;
+            c->total = cpu_total;
+        }
+        p = eol + 1;
+    }
+}
+
+guint
+read_numa (t_numa_node *nodes, guint max_nodes)
+{
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (SYSFS_NODE "/online"), &length);
+    if (!contents)
+        return 0;
+
+    if (online == NULL || strlen (online) != length || memcmp (online, contents, length) != 0)
+    {
+        g_free (online);
+        online = g_strndup (contents, length);
+        load_nodes (online, length);
+    }
+
+    guint64 used[NUMA_MAX_NODES] = {};
+    guint64 total[NUMA_MAX_NODES] = {};
+    read_node_times (used, total);
+
+    gint64 now = g_get_monotonic_time ();
+    gdouble seconds = prev_time != 0 ? (now - prev_time) / (gdouble) G_USEC_PER_SEC : 0;
+    prev_time = now;
+
+    guint n = 0;
+    for (guint node = 0; node < n_nodes && n < max_nodes; node++)
+    {
+        t_numa_node *out = &nodes[n];
+        guint64 miss, foreign;
+
+        out->id = node_ids[node];
+        if (!read_node_meminfo (out->id, out))
+            continue;
+        out->cpu = total[node] != 0 ? MIN ((100 * used[node] + total[node] / 2) / total[node], 100) : 0;
+
+        read_node_numastat (out->id, &miss, &foreign);
+        out->miss_rate = out->foreign_rate = 0;
+        if (seconds > 0 && miss >= prev_miss[node] && foreign >= prev_foreign[node])
+        {
+            out->miss_rate = (miss - prev_miss[node]) / seconds;
+            out->foreign_rate = (foreign - prev_foreign[node]) / seconds;
+        }
+        prev_miss[node] = miss;
+        prev_foreign[node] = foreign;
+        n++;
+    }
+
+    return n;
+}
+
+#else
+
+guint
+read_numa (t_numa_node *nodes, guint max_nodes)
+{
+    return 0;
+}
+
+#endif
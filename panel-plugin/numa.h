@@ -0,0 +1,58 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_NUMA_H_
+#define _XFCE_SYSTEMLOAD_NUMA_H_
+
+#include <glib.h>
+
+/*
+ * Per-node memory and CPU utilization of NUMA machines, read from
+ * /sys/devices/system/node/node* (meminfo, numastat and cpulist).
+ * A single node can run out of memory while the machine as a whole has
+ * plenty free, and allocations then spill over to remote nodes.
+ */
+
+#define NUMA_MAX_NODES 16
+
+struct t_numa_node {
+    guint   id;
+    gulong  mem_total;      /* KiB */
+    gulong  mem_used;       /* KiB, without the page cache and reclaimable slab */
+    guint   cpu;            /* Percent, average over the CPUs of the node */
+    gdouble miss_rate;      /* Pages per second allocated here but intended for another node */
+    gdouble foreign_rate;   /* Pages per second intended for this node but allocated elsewhere */
+};
+
+/*
+ * Reads the online nodes, returns their number or 0 if the machine has no
+ * NUMA information. The CPU loads are computed from /proc/stat since the
+ * previous call, independently of the CPU monitor.
+ */
+guint   read_numa   (t_numa_node *nodes, guint max_nodes);
+
+#endif /* _XFCE_SYSTEMLOAD_NUMA_H_ */
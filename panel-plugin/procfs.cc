@@ -0,0 +1,530 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include "procfs.h"
+#include "scan.h"
+#include "trace.h"
+
+/* Initial buffer size, buffers grow when a file doesn't fit */
+#define INITIAL_SIZE 4096
+
+/* Most sysfs attributes hold a single value */
+#define INITIAL_SYSFS_SIZE 64
+
+/* The registry uses at most this share of the RLIMIT_NOFILE soft limit, the rest is left to the panel */
+#define FD_LIMIT_DIVISOR 4
+
+/* Open files without a soft limit */
+#define DEFAULT_MAX_OPEN 1024
+
+/* Open files left to the monitors with a few files each, see procfs_budget() */
+#define RESERVED_OPEN 64
+
+/* Microseconds before a missing or failing file is opened again */
+#define RETRY_INTERVAL (10 * G_USEC_PER_SEC)
+
+struct t_procfs_file {
+    gchar    *path;      /* NULL if the slot is free */
+    gint      fd;        /* -1 if the file is missing or failed */
+    gint64    retry_time;
+    gchar    *buf;       /* Allocated when the file is opened for the first time */
+    gsize     size;      /* Capacity of buf including the terminating NUL */
+    gssize    length;    /* Length of the prefetched contents, -1 if none */
+    guint32   readers;
+    gint      uring_slot;   /* Index among the registered files and buffers, -1 if none */
+    bool      warned;    /* Failures are only reported once per file */
+};
+
+static t_procfs_file *files;
+static guint          n_files;        /* Slots in use or freed */
+static guint          max_files;      /* Capacity of files */
+static guint          n_open;
+static guint          max_open;       /* 0 = not initialized */
+static GHashTable    *paths;          /* Path -> slot + 1 */
+static guint32        current_reader;
+static gint           benchmark_rounds = -1;   /* -1 = not initialized */
+static bool           files_changed;          /* A file was opened or closed since the last batch */
+static bool           buffers_moved;          /* A buffer was reallocated since the last batch */
+
+static void
+init_registry ()
+{
+    struct rlimit limit;
+
+    paths = g_hash_table_new (g_str_hash, g_str_equal);
+    if (getrlimit (RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        max_open = MAX (limit.rlim_cur / FD_LIMIT_DIVISOR, 16);
+    else
+        max_open = DEFAULT_MAX_OPEN;
+}
+
+static void
+close_fd (t_procfs_file *f)
+{
+    if (f->fd < 0)
+        return;
+    close (f->fd);
+    f->fd = -1;
+    f->length = -1;
+    n_open--;
+    files_changed = true;
+}
+
+/* Opens the file of a registered slot, failures are retried after RETRY_INTERVAL */
+static bool
+open_file (t_procfs_file *f)
+{
+    f->retry_time = g_get_monotonic_time () + RETRY_INTERVAL;
+
+    if (n_open >= max_open)
+    {
+        if (!f->warned)
+            g_warning ("Too many files to monitor, cannot open '%s'", f->path);
+        f->warned = true;
+        return false;
+    }
+
+    f->fd = open (f->path, O_RDONLY | O_CLOEXEC);
+    if (f->fd < 0)
+        return false;
+
+    if (f->buf == NULL)
+    {
+        f->size = g_str_has_prefix (f->path, "/sys/") ? INITIAL_SYSFS_SIZE : INITIAL_SIZE;
+        f->buf = (gchar*) g_malloc (f->size);
+        buffers_moved = true;
+    }
+    f->length = -1;
+    n_open++;
+    files_changed = true;
+    return true;
+}
+
+static bool
+read_file (t_procfs_file *f)
+{
+    for (;;)
+    {
+        ssize_t n = pread (f->fd, f->buf, f->size - 1, 0);
+        if (n < 0)
+        {
+            /* Like sysfs attributes of a CPU that went offline, the file is opened again later */
+            if (!f->warned)
+                g_warning ("Cannot read '%s': %s", f->path, g_strerror (errno));
+            f->warned = true;
+            close_fd (f);
+            f->retry_time = g_get_monotonic_time () + RETRY_INTERVAL;
+            return false;
+        }
+        if ((gsize) n < f->size - 1)
+        {
+            f->buf[n] = '\0';
+            f->length = n;
+            return true;
+        }
+
+        /* The file may have been truncated, retry with a larger buffer */
+        f->size *= 2;
+        f->buf = (gchar*) g_realloc (f->buf, f->size);
+        buffers_moved = true;
+    }
+}
+
+#ifdef HAVE_LIBURING
+
+/* Larger batches are submitted in several rounds */
+#define URING_DEPTH 256
+
+enum UringState {
+    URING_UNTRIED,
+    URING_READY,
+    URING_FAILED,
+};
+
+static struct io_uring ring;
+static UringState      uring_state;
+static guint           uring_registered;       /* Registered files and buffers */
+static bool            uring_buffers_registered;
+
+static void
+uring_fail (const gchar *what, gint ret)
+{
+    g_warning ("%s failed: %s, falling back to pread()", what, g_strerror (-ret));
+    io_uring_queue_exit (&ring);
+    uring_state = URING_FAILED;
+}
+
+/* Registers the open files and their buffers again if any changed since the last batch */
+static bool
+uring_prepare ()
+{
+    gint ret;
+
+    if (uring_state == URING_UNTRIED)
+    {
+        ret = io_uring_queue_init (URING_DEPTH, &ring, 0);
+        if (ret < 0)
+        {
+            /* Expected on old kernels or if io_uring is disabled by sysctl */
+            g_debug ("io_uring is not available: %s", g_strerror (-ret));
+            uring_state = URING_FAILED;
+            return false;
+        }
+        uring_state = URING_READY;
+    }
+    if (uring_state != URING_READY)
+        return false;
+
+    if (files_changed)
+    {
+        /* Only the open files are registered, slot i of the ring is the i-th of them */
+        gint *fds = g_new (gint, MAX (n_open, 1));
+        guint n = 0;
+        for (guint i = 0; i < n_files; i++)
+        {
+            t_procfs_file *f = &files[i];
+            f->uring_slot = f->fd >= 0 ? (gint) n : -1;
+            if (f->fd >= 0)
+                fds[n++] = f->fd;
+        }
+
+        if (uring_registered != 0)
+            io_uring_unregister_files (&ring);
+        uring_registered = 0;
+        ret = n != 0 ? io_uring_register_files (&ring, fds, n) : 0;
+        g_free (fds);
+        if (ret < 0)
+        {
+            uring_fail ("io_uring_register_files()", ret);
+            return false;
+        }
+        uring_registered = n;
+        files_changed = false;
+        buffers_moved = true;
+    }
+
+    if (buffers_moved)
+    {
+        struct iovec *iov = g_new (struct iovec, MAX (uring_registered, 1));
+        for (guint i = 0; i < n_files; i++)
+        {
+            const t_procfs_file *f = &files[i];
+            if (f->uring_slot >= 0)
+            {
+                iov[f->uring_slot].iov_base = f->buf;
+                iov[f->uring_slot].iov_len = f->size;
+            }
+        }
+
+        if (uring_buffers_registered)
+            io_uring_unregister_buffers (&ring);
+        uring_buffers_registered = false;
+        ret = uring_registered != 0 ? io_uring_register_buffers (&ring, iov, uring_registered) : 0;
+        g_free (iov);
+        if (ret < 0)
+        {
+            uring_fail ("io_uring_register_buffers()", ret);
+            return false;
+        }
+        uring_buffers_registered = uring_registered != 0;
+        buffers_moved = false;
+    }
+
+    return true;
+}
+
+/* Submits the prepared reads and stores the results */
+static bool
+uring_complete (guint submitted)
+{
+    gint ret = io_uring_submit_and_wait (&ring, submitted);
+    if (ret < 0)
+    {
+        uring_fail ("io_uring_submit_and_wait()", ret);
+        return false;
+    }
+
+    struct io_uring_cqe *cqe;
+    guint head, seen = 0;
+    io_uring_for_each_cqe (&ring, head, cqe)
+    {
+        t_procfs_file *f = &files[GPOINTER_TO_UINT (io_uring_cqe_get_data (cqe))];
+
+        /* Failed or possibly truncated reads are repeated by procfs_read() */
+        if (cqe->res >= 0 && (gsize) cqe->res < f->size - 1)
+        {
+            f->buf[cqe->res] = '\0';
+            f->length = cqe->res;
+        }
+        seen++;
+    }
+    io_uring_cq_advance (&ring, seen);
+
+    return true;
+}
+
+/* Reads the files of the readers with as few submissions as possible, returns false if io_uring can't be used */
+static bool
+uring_read_batch (guint32 readers)
+{
+    guint submitted = 0;
+
+    if (!uring_prepare ())
+        return false;
+
+    for (guint i = 0; i < n_files; i++)
+    {
+        t_procfs_file *f = &files[i];
+        if (!(f->readers & readers) || f->uring_slot < 0)
+            continue;
+
+        if (submitted == URING_DEPTH)
+        {
+            if (!uring_complete (submitted))
+                return false;
+            submitted = 0;
+        }
+
+        struct io_uring_sqe *sqe = io_uring_get_sqe (&ring);
+        io_uring_prep_read_fixed (sqe, f->uring_slot, f->buf, f->size - 1, 0, f->uring_slot);
+        io_uring_sqe_set_flags (sqe, IOSQE_FIXED_FILE);
+        io_uring_sqe_set_data (sqe, GUINT_TO_POINTER (i));
+        submitted++;
+    }
+
+    return submitted == 0 || uring_complete (submitted);
+}
+
+#endif /* HAVE_LIBURING */
+
+static void
+run_benchmark (guint32 readers)
+{
+    const guint rounds = benchmark_rounds;
+    guint n = 0;
+    gint64 start, pread_time, uring_time = -1;
+
+    for (guint i = 0; i < n_files; i++)
+        if (files[i].fd >= 0 && (files[i].readers & readers))
+            n++;
+
+    start = g_get_monotonic_time ();
+    for (guint r = 0; r < rounds; r++)
+        for (guint i = 0; i < n_files; i++)
+            if (files[i].fd >= 0 && (files[i].readers & readers))
+                read_file (&files[i]);
+    pread_time = g_get_monotonic_time () - start;
+
+#ifdef HAVE_LIBURING
+    start = g_get_monotonic_time ();
+    bool ok = true;
+    for (guint r = 0; r < rounds && ok; r++)
+        ok = uring_read_batch (readers);
+    if (ok)
+        uring_time = g_get_monotonic_time () - start;
+#endif
+
+    for (guint i = 0; i < n_files; i++)
+        files[i].length = -1;
+
+    if (uring_time >= 0)
+        g_message ("procfs benchmark, %u files, %u rounds: pread %.1f \302\265s, io_uring %.1f \302\265s per round",
+                   n, rounds, (gdouble) pread_time / rounds, (gdouble) uring_time / rounds);
+    else
+        g_message ("procfs benchmark, %u files, %u rounds: pread %.1f \302\265s per round, io_uring not available",
+                   n, rounds, (gdouble) pread_time / rounds);
+}
+
+gint
+procfs_open (const gchar *path)
+{
+    if (G_UNLIKELY (paths == NULL))
+        init_registry ();
+
+    gpointer found = g_hash_table_lookup (paths, path);
+    if (found)
+    {
+        guint i = GPOINTER_TO_UINT (found) - 1;
+        t_procfs_file *f = &files[i];
+        if (f->fd < 0 && (g_get_monotonic_time () < f->retry_time || !open_file (f)))
+            return -1;
+        return i;
+    }
+
+    /* Reuse the slot of a closed file */
+    guint i = 0;
+    while (i < n_files && files[i].path != NULL)
+        i++;
+    if (i == n_files)
+    {
+        if (n_files == max_files)
+        {
+            max_files = MAX (2 * max_files, 64);
+            files = g_renew (t_procfs_file, files, max_files);
+        }
+        n_files++;
+    }
+
+    t_procfs_file *f = &files[i];
+    memset (f, 0, sizeof (*f));
+    f->path = g_strdup (path);
+    f->fd = -1;
+    f->length = -1;
+    f->uring_slot = -1;
+    g_hash_table_insert (paths, f->path, GUINT_TO_POINTER (i + 1));
+
+    /* Missing files stay registered, asking again before RETRY_INTERVAL is cheap */
+    return open_file (f) ? (gint) i : -1;
+}
+
+guint
+procfs_budget ()
+{
+    if (G_UNLIKELY (paths == NULL))
+        init_registry ();
+    return n_open + RESERVED_OPEN < max_open ? max_open - n_open - RESERVED_OPEN : 0;
+}
+
+void
+procfs_close (gint file)
+{
+    if (file < 0 || (guint) file >= n_files || files[file].path == NULL)
+        return;
+
+    t_procfs_file *f = &files[file];
+    close_fd (f);
+    g_hash_table_remove (paths, f->path);
+    g_free (f->path);
+    g_free (f->buf);
+    memset (f, 0, sizeof (*f));
+    f->fd = -1;
+    f->uring_slot = -1;
+}
+
+const gchar *
+procfs_read (gint file, gsize *length)
+{
+    if (file < 0 || (guint) file >= n_files || files[file].path == NULL)
+        return NULL;
+
+    t_procfs_file *f = &files[file];
+    f->readers |= current_reader;
+
+    if (f->fd < 0 && (g_get_monotonic_time () < f->retry_time || !open_file (f)))
+        return NULL;
+    if (f->length < 0 && !read_file (f))
+        return NULL;
+
+    *length = f->length;
+    f->length = -1;
+    return f->buf;
+}
+
+bool
+procfs_read_number (const gchar *path, guint64 *value)
+{
+    gchar buf[64];
+    gint fd = open (path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    ssize_t n = read (fd, buf, sizeof (buf));
+    close (fd);
+
+    const gchar *p = buf;
+    return n > 0 && scan_number (&p, buf + n, value);
+}
+
+void
+procfs_set_reader (guint32 reader)
+{
+    current_reader = reader;
+}
+
+void
+procfs_prefetch (guint32 readers)
+{
+    if (G_UNLIKELY (benchmark_rounds < 0))
+    {
+        const gchar *env = g_getenv ("SYSTEMLOAD_PROCFS_BENCHMARK");
+        benchmark_rounds = env ? atoi (env) : 0;
+        /* Wait for the files to be registered by the first update */
+        if (benchmark_rounds > 0)
+            return;
+    }
+    else if (G_UNLIKELY (benchmark_rounds > 0))
+    {
+        run_benchmark (readers);
+        benchmark_rounds = 0;
+    }
+
+#ifdef HAVE_LIBURING
+    TRACE_SCOPE ("procfs_prefetch");
+
+    /* Contents prefetched earlier but never read are stale by now */
+    for (guint i = 0; i < n_files; i++)
+        files[i].length = -1;
+    uring_read_batch (readers);
+#endif
+}
+
+void
+procfs_shutdown ()
+{
+#ifdef HAVE_LIBURING
+    if (uring_state == URING_READY)
+        io_uring_queue_exit (&ring);
+    uring_state = URING_UNTRIED;
+    uring_registered = 0;
+    uring_buffers_registered = false;
+#endif
+
+    for (guint i = 0; i < n_files; i++)
+    {
+        if (files[i].fd >= 0)
+            close (files[i].fd);
+        g_free (files[i].path);
+        g_free (files[i].buf);
+    }
+    g_free (files);
+    files = NULL;
+    n_files = max_files = n_open = 0;
+    if (paths)
+        g_hash_table_destroy (paths);
+    paths = NULL;
+    files_changed = buffers_moved = false;
+}
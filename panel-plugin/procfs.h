@@ -0,0 +1,91 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_PROCFS_H_
+#define _XFCE_SYSTEMLOAD_PROCFS_H_
+
+#include <glib.h>
+
+/*
+ * Registry of the procfs and sysfs files read by the monitors. The files
+ * stay open and are re-read from offset 0 with pread(), which avoids the
+ * open/close syscalls on every update. Files that are missing or fail to
+ * read (sysfs attributes go away with their device) are reported once and
+ * opened again at most every few seconds. The registry keeps at most a
+ * quarter of the RLIMIT_NOFILE soft limit open. Monitors reading files of
+ * every CPU register them only within procfs_budget() and read the others
+ * on demand with procfs_read_number().
+ *
+ * Files remember which readers (a bit mask set by procfs_set_reader())
+ * used them. With io_uring available, procfs_prefetch() reads all files
+ * of the given readers in one batch with a single io_uring_enter() call,
+ * using registered files and fixed buffers. procfs_read() returns the
+ * prefetched contents or falls back to pread().
+ *
+ * Setting SYSTEMLOAD_PROCFS_BENCHMARK to a number of rounds compares both
+ * methods on the registered files once and reports via g_message().
+ */
+
+/*
+ * Returns the id of the file, opening it if needed, or -1 on failure.
+ * Looking up a registered file is cheap, also for missing files, readers
+ * don't need to keep the id.
+ */
+gint          procfs_open        (const gchar *path);
+
+/*
+ * Number of files that can still be opened, keeping a reserve for the
+ * monitors with a few files each
+ */
+guint         procfs_budget      ();
+
+/* Closes the file and forgets its id, for files that won't be read again */
+void          procfs_close       (gint file);
+
+/*
+ * Returns the current NUL-terminated contents of the file, valid until
+ * the next call for the same file, or NULL on failure. Passing the result
+ * of procfs_open() directly is fine, an id of -1 returns NULL.
+ */
+const gchar  *procfs_read        (gint file, gsize *length);
+
+/*
+ * Reads the first number of a file without keeping it open, for values
+ * that don't change like the maximum frequency of a CPU.
+ */
+bool          procfs_read_number (const gchar *path, guint64 *value);
+
+/* Attributes the files read from now on to the given readers */
+void          procfs_set_reader  (guint32 reader);
+
+/* Reads the files of the given readers ahead, does nothing without io_uring */
+void          procfs_prefetch    (guint32 readers);
+
+/* Closes all files */
+void          procfs_shutdown    ();
+
+#endif /* _XFCE_SYSTEMLOAD_PROCFS_H_ */
@@ -0,0 +1,182 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
+
+#include "scan.h"
+
+typedef const gchar *(*t_find_func) (const gchar *p, const gchar *end, bool digit);
+
+static inline bool
+is_digit (gchar c)
+{
+    return (guchar) (c - '0') < 10;
+}
+
+static const gchar *
+find_scalar (const gchar *p, const gchar *end, bool digit)
+{
+    while (p < end && is_digit (*p) != digit)
+        p++;
+    return p;
+}
+
+#ifdef SCAN_X86
+
+__attribute__ ((target ("sse2")))
+static const gchar *
+find_sse2 (const gchar *p, const gchar *end, bool digit)
+{
+    const __m128i zero = _mm_set1_epi8 ('0');
+    const __m128i nine = _mm_set1_epi8 (9);
+    const guint flip = digit ? 0 : 0xffff;
+
+    for (; end - p >= 16; p += 16)
+    {
+        /* c - '0' is at most 9 for digits, as unsigned bytes */
+        __m128i d = _mm_sub_epi8 (_mm_loadu_si128 ((const __m128i*) p), zero);
+        guint mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_min_epu8 (d, nine), d)) ^ flip;
+        if (mask != 0)
+            return p + __builtin_ctz (mask);
+    }
+    return find_scalar (p, end, digit);
+}
+
+__attribute__ ((target ("avx2")))
+static const gchar *
+find_avx2 (const gchar *p, const gchar *end, bool digit)
+{
+    const __m256i zero = _mm256_set1_epi8 ('0');
+    const __m256i nine = _mm256_set1_epi8 (9);
+    const guint32 flip = digit ? 0 : 0xffffffff;
+
+    for (; end - p >= 32; p += 32)
+    {
+        __m256i d = _mm256_sub_epi8 (_mm256_loadu_si256 ((const __m256i*) p), zero);
+        guint32 mask = (guint32) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (_mm256_min_epu8 (d, nine), d)) ^ flip;
+        if (mask != 0)
+            return p + __builtin_ctz (mask);
+    }
+    return find_sse2 (p, end, digit);
+}
+
+#endif /* SCAN_X86 */
+
+static t_find_func
+select_find ()
+{
+#ifdef SCAN_X86
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+        return find_avx2;
+    if (__builtin_cpu_supports ("sse2"))
+        return find_sse2;
+#endif
+    return find_scalar;
+}
+
+static inline const gchar *
+find (const gchar *p, const gchar *end, bool digit)
+{
+    static t_find_func func;
+    if (G_UNLIKELY (func == NULL))
+        func = select_find ();
+
+    /* Most runs in procfs files are short, check the first byte inline */
+    if (p < end && is_digit (*p) == digit)
+        return p;
+    return func (p, end, digit);
+}
+
+/* Converts 8 digits at once, see "SIMD-within-a-register" digit parsing */
+static inline guint64
+parse_8_digits (const gchar *p)
+{
+    guint64 v;
+    memcpy (&v, p, sizeof (v));
+    v = GUINT64_FROM_LE (v);
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32))) +
+         (((v >> 16) & 0x000000ff000000ffULL) * (1 + (10000ULL << 32)))) >> 32;
+    return v;
+}
+
+static inline guint64
+parse_digits (const gchar *p, const gchar *end)
+{
+    guint64 value = 0;
+
+    for (; end - p >= 8; p += 8)
+        value = value * 100000000 + parse_8_digits (p);
+    for (; p < end; p++)
+        value = value * 10 + (*p - '0');
+    return value;
+}
+
+const gchar *
+scan_find_digit (const gchar *p, const gchar *end)
+{
+    return find (p, end, true);
+}
+
+const gchar *
+scan_skip_digits (const gchar *p, const gchar *end)
+{
+    return find (p, end, false);
+}
+
+bool
+scan_number (const gchar **p, const gchar *end, guint64 *value)
+{
+    const gchar *start = find (*p, end, true);
+    if (start == end)
+    {
+        *p = end;
+        return false;
+    }
+
+    const gchar *stop = find (start, end, false);
+    *value = parse_digits (start, stop);
+    *p = stop;
+    return true;
+}
+
+guint
+scan_numbers (const gchar *p, const gchar *end, guint64 *values, guint n_values)
+{
+    guint n = 0;
+    while (n < n_values && scan_number (&p, end, &values[n]))
+        n++;
+    return n;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_SCAN_H_
+#define _XFCE_SYSTEMLOAD_SCAN_H_
+
+#include <glib.h>
+#include <string.h>
+
+/*
+ * Scanner for the unsigned decimal numbers in procfs text files. Digit
+ * runs and their boundaries are located 16 or 32 bytes at a time with
+ * SSE2 or AVX2 when the CPU supports it, and runs are converted 8 digits
+ * at a time. Unlike the scanf family it ignores the locale.
+ *
+ * All functions take the end of the text explicitly and never read past
+ * it, the text doesn't need to be NUL-terminated.
+ */
+
+/* Returns the first digit in [p, end), or end */
+const gchar  *scan_find_digit   (const gchar *p, const gchar *end);
+
+/* Returns the first non-digit in [p, end), or end */
+const gchar  *scan_skip_digits  (const gchar *p, const gchar *end);
+
+/*
+ * Parses the next number in [*p, end), skipping any non-digits before it,
+ * and advances *p past it. Returns false if there is no number left.
+ */
+bool          scan_number       (const gchar **p, const gchar *end, guint64 *value);
+
+/*
+ * Parses up to n_values numbers in [p, end) separated by any non-digits,
+ * returns the number of values parsed
+ */
+guint         scan_numbers      (const gchar *p, const gchar *end, guint64 *values, guint n_values);
+
+/* Returns the newline ending the line that starts at p, or end */
+static inline const gchar *
+scan_line_end (const gchar *p, const gchar *end)
+{
+    const gchar *eol = (const gchar*) memchr (p, '\n', end - p);
+    return eol ? eol : end;
+}
+
+/*
+ * Parses a sysfs list of ranges like "0-3,8-11\n" and calls func (first, last)
+ * for each range. Returns false if the list is malformed.
+ */
+template<typename F>
+static inline bool
+scan_ranges (const gchar *p, const gchar *end, F func)
+{
+    while (p < end && *p != '\n')
+    {
+        guint64 first, last;
+        if (!scan_number (&p, end, &first))
+            return false;
+        last = first;
+        if (p < end && *p == '-')
+        {
+            p++;
+            if (!scan_number (&p, end, &last) || last < first)
+                return false;
+        }
+        func (first, last);
+        if (p < end && *p == ',')
+            p++;
+    }
+    return true;
+}
+
+#endif /* _XFCE_SYSTEMLOAD_SCAN_H_ */
@@ -0,0 +1,133 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "schedstat.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+/* Same bound as the CPUs of /proc/stat, protects against garbage */
+#define MAX_CPU 8191
+
+struct t_cpu_counters {
+    guint64 wait;       /* Nanoseconds */
+    guint64 slices;
+    bool    valid;
+};
+
+/* Counters of the previous read, indexed by CPU */
+static t_cpu_counters *prev;
+static guint           n_prev;
+static gint64          prev_time;
+
+gint
+read_schedstat (t_schedstat *stat)
+{
+    const gchar *filepath = "/proc/schedstat";
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (filepath), &length);
+    if (!contents)
+    {
+        g_warning ("Cannot read '%s'", filepath);
+        return -1;
+    }
+
+    gint64 now = g_get_monotonic_time ();
+    const gint64 elapsed = prev_time != 0 ? now - prev_time : 0;
+    prev_time = now;
+
+    guint64 wait = 0, slices = 0;
+    stat->n_cpus = 0;
+    stat->worst_cpu = 0;
+    stat->worst_wait_per_slice = 0;
+
+    const gchar *end = contents + length;
+    for (const gchar *p = contents; p < end; p++)
+    {
+        const gchar *eol = scan_line_end (p, end);
+
+        /*
+         * Looks like "cpu0 0 0 162 32 73 46 1849120 286934 130", the last
+         * three numbers are the running time, the waiting time (both in
+         * nanoseconds) and the timeslices. The lines of the scheduling
+         * domains follow each CPU.
+         */
+        if (eol - p > 3 && memcmp (p, "cpu", 3) == 0 && g_ascii_isdigit (p[3]))
+        {
+            guint64 v[16];
+            guint n = scan_numbers (p + 3, eol, v, G_N_ELEMENTS (v));
+            if (n >= 4 && v[0] <= MAX_CPU)
+            {
+                const guint cpu = v[0];
+                if (cpu >= n_prev)
+                {
+                    prev = g_renew (t_cpu_counters, prev, cpu + 1);
+                    memset (prev + n_prev, 0, (cpu + 1 - n_prev) * sizeof (*prev));
+                    n_prev = cpu + 1;
+                }
+
+                t_cpu_counters *c = &prev[cpu];
+                const guint64 cpu_wait = v[n - 2], cpu_slices = v[n - 1];
+                if (c->valid && cpu_slices > c->slices && cpu_wait >= c->wait)
+                {
+                    const guint64 dw = cpu_wait - c->wait, ds = cpu_slices - c->slices;
+                    const gdouble per_slice = dw / 1000.0 / ds;
+                    if (per_slice >= stat->worst_wait_per_slice)
+                    {
+                        stat->worst_cpu = cpu;
+                        stat->worst_wait_per_slice = per_slice;
+                    }
+                    wait += dw;
+                    slices += ds;
+                }
+                c->wait = cpu_wait;
+                c->slices = cpu_slices;
+                c->valid = true;
+                stat->n_cpus++;
+            }
+        }
+        p = eol;
+    }
+
+    stat->wait_per_slice = slices != 0 ? wait / 1000.0 / slices : 0;
+    stat->waiting = elapsed != 0 && stat->n_cpus != 0 ? wait / 1000.0 / elapsed / stat->n_cpus : 0;
+    return 0;
+}
+
+#else
+
+gint
+read_schedstat (t_schedstat *stat)
+{
+    return -1;
+}
+
+#endif
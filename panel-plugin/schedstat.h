@@ -0,0 +1,52 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_SCHEDSTAT_H_
+#define _XFCE_SYSTEMLOAD_SCHEDSTAT_H_
+
+#include <glib.h>
+
+/*
+ * Runqueue delays from the per-CPU lines of /proc/schedstat, which count
+ * the time tasks spent running, the time runnable tasks spent waiting for
+ * the CPU and the number of timeslices. The wait per timeslice is the
+ * scheduling latency a task sees whenever it becomes runnable, unlike the
+ * CPU load it rises as soon as tasks compete for a CPU.
+ */
+
+struct t_schedstat {
+    guint   n_cpus;
+    gdouble wait_per_slice;     /* Microseconds, average over all timeslices */
+    gdouble waiting;            /* Average number of tasks waiting per CPU */
+    guint   worst_cpu;
+    gdouble worst_wait_per_slice;   /* Microseconds, of the CPU with the longest waits */
+};
+
+/* Returns 0 on success, the delays are 0 after the first read */
+gint    read_schedstat  (t_schedstat *stat);
+
+#endif /* _XFCE_SYSTEMLOAD_SCHEDSTAT_H_ */
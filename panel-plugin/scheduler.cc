@@ -0,0 +1,292 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_TIMERFD
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#include "scheduler.h"
+#include "stats.h"
+#include "trace.h"
+
+#define DEFAULT_SLACK 1000
+
+struct t_task {
+    guint   interval;  /* Milliseconds as requested, 0 if stopped */
+    gint64  period;    /* Microseconds after scaling, 0 if stopped or paused */
+    gint64  next_due;  /* Monotonic time */
+};
+
+struct t_scheduler_source {
+    GSource       source;
+    t_scheduler  *scheduler;
+};
+
+struct t_scheduler {
+    GSource           *source;
+    gint               timer_fd;   /* -1 if the ready time of the source is used */
+    t_scheduler_func   func;
+    gpointer           user_data;
+    gdouble            scale;
+    gint64             origin;
+    gint64             slack;
+    gint64             wakeup;     /* Armed wakeup, -1 if disarmed */
+    t_task             tasks[SCHEDULER_MAX_TASKS];
+};
+
+static void scheduler_run (t_scheduler *scheduler);
+
+static gboolean
+scheduler_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
+{
+    t_scheduler *scheduler = ((t_scheduler_source*) source)->scheduler;
+
+#ifdef HAVE_TIMERFD
+    if (scheduler->timer_fd >= 0)
+    {
+        /* Drain the expiration count, the timer is one-shot */
+        guint64 expirations;
+        if (read (scheduler->timer_fd, &expirations, sizeof (expirations)) < 0 && errno != EAGAIN)
+            g_warning ("Cannot read timerfd: %s", g_strerror (errno));
+    }
+#endif
+
+    scheduler_run (scheduler);
+    return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs scheduler_source_funcs = {
+    NULL,
+    NULL,
+    scheduler_dispatch,
+    NULL,
+    NULL,
+    NULL,
+};
+
+/* First grid point of the task after now */
+static gint64
+next_grid_point (const t_scheduler *scheduler, const t_task *task, gint64 now)
+{
+    return scheduler->origin + ((now - scheduler->origin) / task->period + 1) * task->period;
+}
+
+/*
+ * Wakes up at the earliest due time, or later by up to the slack if this
+ * batches more tasks into the same wakeup.
+ */
+static void
+scheduler_arm (t_scheduler *scheduler)
+{
+    gint64 earliest = -1;
+    gint64 wakeup;
+
+    for (guint i = 0; i < SCHEDULER_MAX_TASKS; i++)
+    {
+        const t_task *task = &scheduler->tasks[i];
+        if (task->period != 0 && (earliest < 0 || task->next_due < earliest))
+            earliest = task->next_due;
+    }
+
+    wakeup = earliest;
+    for (guint i = 0; i < SCHEDULER_MAX_TASKS && earliest >= 0; i++)
+    {
+        const t_task *task = &scheduler->tasks[i];
+        if (task->period != 0 && task->next_due <= earliest + scheduler->slack)
+            wakeup = MAX (wakeup, task->next_due);
+    }
+    scheduler->wakeup = wakeup;
+
+#ifdef HAVE_TIMERFD
+    if (scheduler->timer_fd >= 0)
+    {
+        /* An all-zero value disarms the timer */
+        struct itimerspec spec = {};
+        if (wakeup >= 0)
+        {
+            spec.it_value.tv_sec = wakeup / G_USEC_PER_SEC;
+            spec.it_value.tv_nsec = (wakeup % G_USEC_PER_SEC) * 1000;
+            if (wakeup == 0)
+                spec.it_value.tv_nsec = 1;
+        }
+        if (timerfd_settime (scheduler->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) == 0)
+            return;
+        g_warning ("Cannot arm timerfd: %s", g_strerror (errno));
+    }
+#endif
+
+    g_source_set_ready_time (scheduler->source, wakeup);
+}
+
+static void
+task_reset (t_scheduler *scheduler, t_task *task, gint64 now)
+{
+    task->period = (gint64) (task->interval * 1000.0 * scheduler->scale);
+    if (task->period != 0)
+        task->next_due = next_grid_point (scheduler, task, now);
+}
+
+static void
+scheduler_run (t_scheduler *scheduler)
+{
+    gint64 now = g_get_monotonic_time ();
+    gint64 earliest = G_MAXINT64;
+    const gint64 wakeup = scheduler->wakeup;
+    guint32 due = 0;
+    guint missed = 0;
+
+    for (guint i = 0; i < SCHEDULER_MAX_TASKS; i++)
+    {
+        t_task *task = &scheduler->tasks[i];
+        if (task->period == 0 || task->next_due > now)
+            continue;
+
+        due |= 1u << i;
+        earliest = MIN (earliest, task->next_due);
+
+        /*
+         * The grid points that passed while the main loop was busy are
+         * skipped rather than run back to back, but they are reported.
+         */
+        task->next_due += task->period;
+        if (task->next_due <= now)
+        {
+            missed += (now - task->next_due) / task->period + 1;
+            task->next_due = next_grid_point (scheduler, task, now);
+        }
+    }
+
+    if (G_UNLIKELY (missed != 0))
+    {
+        stats_record_missed_ticks (missed);
+        trace_instant ("missed-tick");
+        g_debug ("%u updates were skipped, the main loop was blocked for %" G_GINT64_FORMAT " ms",
+                 missed, (now - earliest) / 1000);
+    }
+
+    /* Arm before running the callback, which may change the intervals */
+    scheduler_arm (scheduler);
+
+    if (due != 0)
+    {
+        /* A wakeup delayed on purpose by the slack is only late beyond the armed time */
+        stats_record_value (STATS_LATENESS, MAX (now - (wakeup >= 0 ? wakeup : earliest), 0));
+        scheduler->func (due, scheduler->user_data);
+    }
+}
+
+t_scheduler *
+scheduler_new (t_scheduler_func func, gpointer user_data)
+{
+    auto scheduler = g_new0 (t_scheduler, 1);
+
+    scheduler->func = func;
+    scheduler->user_data = user_data;
+    scheduler->scale = 1.0;
+    scheduler->origin = g_get_monotonic_time ();
+    scheduler->slack = DEFAULT_SLACK;
+    scheduler->wakeup = -1;
+    scheduler->timer_fd = -1;
+
+    scheduler->source = g_source_new (&scheduler_source_funcs, sizeof (t_scheduler_source));
+    ((t_scheduler_source*) scheduler->source)->scheduler = scheduler;
+    g_source_set_name (scheduler->source, "systemload-scheduler");
+
+#ifdef HAVE_TIMERFD
+    /*
+     * The timer is armed with absolute expiration times and fires with
+     * nanosecond precision, the ready time of a GSource is rounded to
+     * milliseconds by poll(). g_get_monotonic_time() uses CLOCK_MONOTONIC.
+     */
+    scheduler->timer_fd = timerfd_create (CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (scheduler->timer_fd >= 0)
+        g_source_add_unix_fd (scheduler->source, scheduler->timer_fd, G_IO_IN);
+    else
+        g_warning ("Cannot create timerfd: %s", g_strerror (errno));
+#endif
+
+    g_source_attach (scheduler->source, NULL);
+
+    return scheduler;
+}
+
+void
+scheduler_free (t_scheduler *scheduler)
+{
+    if (scheduler)
+    {
+        g_source_destroy (scheduler->source);
+        g_source_unref (scheduler->source);
+#ifdef HAVE_TIMERFD
+        if (scheduler->timer_fd >= 0)
+            close (scheduler->timer_fd);
+#endif
+        g_free (scheduler);
+    }
+}
+
+void
+scheduler_set_interval (t_scheduler *scheduler, guint task, guint interval)
+{
+    g_return_if_fail (task < SCHEDULER_MAX_TASKS);
+
+    t_task *t = &scheduler->tasks[task];
+    if (t->interval == interval)
+        return;
+
+    t->interval = interval;
+    task_reset (scheduler, t, g_get_monotonic_time ());
+    scheduler_arm (scheduler);
+}
+
+void
+scheduler_set_scale (t_scheduler *scheduler, gdouble scale)
+{
+    if (scheduler->scale == scale)
+        return;
+
+    /* Start a new grid, the old one doesn't match the new periods */
+    gint64 now = g_get_monotonic_time ();
+    scheduler->scale = MAX (scale, 0.0);
+    scheduler->origin = now;
+    for (guint i = 0; i < SCHEDULER_MAX_TASKS; i++)
+        task_reset (scheduler, &scheduler->tasks[i], now);
+    scheduler_arm (scheduler);
+}
+
+void
+scheduler_set_slack (t_scheduler *scheduler, guint slack)
+{
+    if (scheduler->slack == slack)
+        return;
+
+    scheduler->slack = slack;
+    scheduler_arm (scheduler);
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_SCHEDULER_H_
+#define _XFCE_SYSTEMLOAD_SCHEDULER_H_
+
+#include <glib.h>
+
+/*
+ * Runs periodic tasks with individual intervals from a single main loop
+ * source. The source wakes up once for the earliest due task and passes
+ * all tasks due at that moment to the callback as one bit mask.
+ *
+ * The due times of all tasks lie on a grid anchored at a common origin,
+ * so tasks with commensurate intervals (like 500 ms and 2 s) fall due at
+ * exactly the same instant and are batched. A late wakeup doesn't shift
+ * the grid, grid points that passed in the meantime are skipped and
+ * counted as missed ticks in the statistics.
+ *
+ * On Linux the source polls a timerfd armed with absolute times, elsewhere
+ * it falls back to the ready time of the source.
+ */
+
+#define SCHEDULER_MAX_TASKS 32
+
+struct t_scheduler;
+
+typedef void (*t_scheduler_func) (guint32 due, gpointer user_data);
+
+t_scheduler *scheduler_new           (t_scheduler_func func, gpointer user_data);
+void         scheduler_free          (t_scheduler *scheduler);
+
+/* Interval of the task in milliseconds, 0 stops the task */
+void         scheduler_set_interval  (t_scheduler *scheduler, guint task, guint interval);
+
+/*
+ * Multiplies all intervals by scale, used to slow down all updates in
+ * power-saving mode. A scale of 0 pauses all tasks.
+ */
+void         scheduler_set_scale     (t_scheduler *scheduler, gdouble scale);
+
+/*
+ * Microseconds by which a wakeup may be delayed to batch tasks that fall
+ * due shortly after each other, 0 wakes up exactly on every due time.
+ */
+void         scheduler_set_slack     (t_scheduler *scheduler, guint slack);
+
+#endif /* _XFCE_SYSTEMLOAD_SCHEDULER_H_ */
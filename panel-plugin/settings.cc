@@ -43,12 +43,55 @@
 #define DEFAULT_TIMEOUT_SECONDS 1
 #define DEFAULT_SYSTEM_MONITOR_COMMAND "xfce4-taskmanager"
 #define DEFAULT_UPTIME_LABEL "%hh %mm"
+#define DEFAULT_WARNING_THRESHOLD 0
+#define DEFAULT_CRITICAL_THRESHOLD 0
+#define DEFAULT_DISPLAY_MODE DISPLAY_MODE_BAR
+#define DEFAULT_ADAPTIVE_MAX_INTERVAL 5000
+#define DEFAULT_ADAPTIVE_BAND 2
+#define DEFAULT_ADAPTIVE_HOLD 4
+#define DEFAULT_TIMER_SLACK 1000
+
+static const bool DEFAULT_ENABLED[] = {
+    true,  /* CPU */
+    true,  /* MEM */
+    true,  /* NET */
+    true,  /* SWAP */
+    false, /* NUMA */
+    false, /* FREQ */
+    false, /* LOAD */
+    false, /* ACTIVITY */
+    false, /* IRQ */
+    false, /* RUNDELAY */
+    false, /* IDLE */
+};
 
 static const gchar *const DEFAULT_LABEL[] = {
     "cpu",
     "mem",
     "net",
     "swap",
+    "numa",
+    "freq",
+    "load",
+    "proc",
+    "irq",
+    "wait",
+    "idle",
+};
+
+/* Name of the monitor in property names, like "cpu" in "cpu-label" */
+static const gchar *const SETTING_NAME[] = {
+    "cpu",
+    "memory",
+    "network",
+    "swap",
+    "numa",
+    "frequency",
+    "loadavg",
+    "activity",
+    "interrupts",
+    "rundelay",
+    "cpuidle",
 };
 
 static const gchar *const DEFAULT_COLOR[] = {
@@ -56,6 +99,13 @@ static const gchar *const DEFAULT_COLOR[] = {
     "#2ec27e", /* MEM */
     "#e66100", /* NET */
     "#f5c211", /* SWAP */
+    "#9141ac", /* NUMA */
+    "#865e3c", /* FREQ */
+    "#c061cb", /* LOAD */
+    "#2190a4", /* ACTIVITY */
+    "#a51d2d", /* IRQ */
+    "#613583", /* RUNDELAY */
+    "#5e5c64", /* IDLE */
 };
 
 
@@ -87,13 +137,28 @@ struct _SystemloadConfig {
   gchar           *system_monitor_command;
   bool             uptime;
   gchar           *uptime_label;
+  bool             uptime_exclude_suspend;
+  guint            warning_threshold;
+  guint            critical_threshold;
+  guint            display_mode;
+  bool             adaptive;
+  guint            adaptive_max_interval;
+  guint            adaptive_band;
+  guint            adaptive_hold;
+  guint            timer_slack;
+  bool             cpu_peak;
+  bool             cpu_heatmap;
+  guint            cpu_aggregation;
+  bool             memory_composition;
+  guint            swap_mode;
 
   struct {
     bool           enabled;
     bool           use_label;
     gchar         *label;
     GdkRGBA        color;
-  } monitor[4];
+    guint          interval;
+  } monitor[N_MONITORS];
 };
 
 enum SystemloadProperty {
@@ -103,23 +168,40 @@ enum SystemloadProperty {
     PROP_SYSTEM_MONITOR_COMMAND,
     PROP_UPTIME,
     PROP_UPTIME_LABEL,
-    PROP_CPU_ENABLED,
-    PROP_CPU_USE_LABEL,
-    PROP_CPU_LABEL,
-    PROP_CPU_COLOR,
-    PROP_MEMORY_ENABLED,
-    PROP_MEMORY_USE_LABEL,
-    PROP_MEMORY_LABEL,
-    PROP_MEMORY_COLOR,
-    PROP_NETWORK_ENABLED,
-    PROP_NETWORK_USE_LABEL,
-    PROP_NETWORK_LABEL,
-    PROP_NETWORK_COLOR,
-    PROP_SWAP_ENABLED,
-    PROP_SWAP_USE_LABEL,
-    PROP_SWAP_LABEL,
-    PROP_SWAP_COLOR,
-    N_PROPERTIES,
+    PROP_UPTIME_EXCLUDE_SUSPEND,
+    PROP_WARNING_THRESHOLD,
+    PROP_CRITICAL_THRESHOLD,
+    PROP_DISPLAY_MODE,
+    PROP_ADAPTIVE,
+    PROP_ADAPTIVE_MAX_INTERVAL,
+    PROP_ADAPTIVE_BAND,
+    PROP_ADAPTIVE_HOLD,
+    PROP_TIMER_SLACK,
+    PROP_CPU_PEAK,
+    PROP_CPU_HEATMAP,
+    PROP_CPU_AGGREGATION,
+    PROP_MEMORY_COMPOSITION,
+    PROP_SWAP_MODE,
+    /* Followed by N_MONITOR_PROPERTIES properties of each monitor, see monitor_property() */
+    PROP_MONITOR_FIRST,
+};
+
+/* Properties every monitor has, named like "cpu-enabled" and stored at "/cpu/enabled" */
+enum SystemloadMonitorProperty {
+    MONITOR_PROP_ENABLED,
+    MONITOR_PROP_USE_LABEL,
+    MONITOR_PROP_LABEL,
+    MONITOR_PROP_COLOR,
+    MONITOR_PROP_INTERVAL,
+    N_MONITOR_PROPERTIES,
+};
+
+static const gchar *const MONITOR_PROPERTY_NAME[] = {
+    "enabled",
+    "use-label",
+    "label",
+    "color",
+    "interval",
 };
 
 enum {
@@ -129,35 +211,29 @@ enum {
 
 static guint systemload_config_signals [LAST_SIGNAL] = { 0, };
 
+/* monitor is -1 if the change isn't specific to a monitor */
+static void
+systemload_config_changed (SystemloadConfig *config, gint monitor, guint changes)
+{
+  g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0, monitor, changes);
+}
+
+static guint
+monitor_property (SystemloadMonitor monitor, SystemloadMonitorProperty property)
+{
+  return PROP_MONITOR_FIRST + monitor * N_MONITOR_PROPERTIES + property;
+}
+
 static SystemloadMonitor
-prop2monitor (SystemloadProperty p)
+prop2monitor (guint prop_id)
 {
-  switch (p)
-    {
-    case PROP_CPU_ENABLED:
-    case PROP_CPU_USE_LABEL:
-    case PROP_CPU_LABEL:
-    case PROP_CPU_COLOR:
-      return CPU_MONITOR;
-    case PROP_MEMORY_ENABLED:
-    case PROP_MEMORY_USE_LABEL:
-    case PROP_MEMORY_LABEL:
-    case PROP_MEMORY_COLOR:
-      return MEM_MONITOR;
-    case PROP_NETWORK_ENABLED:
-    case PROP_NETWORK_USE_LABEL:
-    case PROP_NETWORK_LABEL:
-    case PROP_NETWORK_COLOR:
-      return NET_MONITOR;
-    case PROP_SWAP_ENABLED:
-    case PROP_SWAP_USE_LABEL:
-    case PROP_SWAP_LABEL:
-    case PROP_SWAP_COLOR:
-      return SWAP_MONITOR;
-    default:
-      /* Ideally, this codepath is never reached */
-      return CPU_MONITOR;
-    }
+  return SystemloadMonitor ((prop_id - PROP_MONITOR_FIRST) / N_MONITOR_PROPERTIES);
+}
+
+static SystemloadMonitorProperty
+prop2monitor_property (guint prop_id)
+{
+  return SystemloadMonitorProperty ((prop_id - PROP_MONITOR_FIRST) % N_MONITOR_PROPERTIES);
 }
 
 static GdkRGBA
@@ -242,112 +318,133 @@ systemload_config_class_init (SystemloadConfigClass *klass)
                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_ENABLED,
-                                   g_param_spec_boolean ("cpu-enabled", NULL, NULL,
-                                                         TRUE,
+                                   PROP_UPTIME_EXCLUDE_SUSPEND,
+                                   g_param_spec_boolean ("uptime-exclude-suspend", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_USE_LABEL,
-                                   g_param_spec_boolean ("cpu-use-label", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_WARNING_THRESHOLD,
+                                   g_param_spec_uint ("warning-threshold", NULL, NULL,
+                                                      0, 100, DEFAULT_WARNING_THRESHOLD,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_LABEL,
-                                   g_param_spec_string ("cpu-label", NULL, NULL,
-                                                        DEFAULT_LABEL[CPU_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_CRITICAL_THRESHOLD,
+                                   g_param_spec_uint ("critical-threshold", NULL, NULL,
+                                                      0, 100, DEFAULT_CRITICAL_THRESHOLD,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_COLOR,
-                                   g_param_spec_boxed ("cpu-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_DISPLAY_MODE,
+                                   g_param_spec_uint ("display-mode", NULL, NULL,
+                                                      DISPLAY_MODE_BAR, DISPLAY_MODE_VALUE, DEFAULT_DISPLAY_MODE,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_ENABLED,
-                                   g_param_spec_boolean ("memory-enabled", NULL, NULL,
-                                                         TRUE,
+                                   PROP_ADAPTIVE,
+                                   g_param_spec_boolean ("adaptive", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_USE_LABEL,
-                                   g_param_spec_boolean ("memory-use-label", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_ADAPTIVE_MAX_INTERVAL,
+                                   g_param_spec_uint ("adaptive-max-interval", NULL, NULL,
+                                                      MIN_TIMEOUT, MAX_INTERVAL, DEFAULT_ADAPTIVE_MAX_INTERVAL,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_LABEL,
-                                   g_param_spec_string ("memory-label", NULL, NULL,
-                                                        DEFAULT_LABEL[MEM_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_ADAPTIVE_BAND,
+                                   g_param_spec_uint ("adaptive-band", NULL, NULL,
+                                                      0, 50, DEFAULT_ADAPTIVE_BAND,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_COLOR,
-                                   g_param_spec_boxed ("memory-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_ADAPTIVE_HOLD,
+                                   g_param_spec_uint ("adaptive-hold", NULL, NULL,
+                                                      1, 100, DEFAULT_ADAPTIVE_HOLD,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_ENABLED,
-                                   g_param_spec_boolean ("network-enabled", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_TIMER_SLACK,
+                                   g_param_spec_uint ("timer-slack", NULL, NULL,
+                                                      0, MAX_TIMER_SLACK, DEFAULT_TIMER_SLACK,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_USE_LABEL,
-                                   g_param_spec_boolean ("network-use-label", NULL, NULL,
-                                                         TRUE,
+                                   PROP_CPU_PEAK,
+                                   g_param_spec_boolean ("cpu-peak", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_LABEL,
-                                   g_param_spec_string ("network-label", NULL, NULL,
-                                                        DEFAULT_LABEL[NET_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_CPU_HEATMAP,
+                                   g_param_spec_boolean ("cpu-heatmap", NULL, NULL,
+                                                         FALSE,
+                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_COLOR,
-                                   g_param_spec_boxed ("network-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_CPU_AGGREGATION,
+                                   g_param_spec_uint ("cpu-aggregation", NULL, NULL,
+                                                      CPU_AGGREGATION_ALL, CPU_AGGREGATION_PACKAGE, CPU_AGGREGATION_ALL,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_ENABLED,
-                                   g_param_spec_boolean ("swap-enabled", NULL, NULL,
-                                                         TRUE,
+                                   PROP_MEMORY_COMPOSITION,
+                                   g_param_spec_boolean ("memory-composition", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_USE_LABEL,
-                                   g_param_spec_boolean ("swap-use-label", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_SWAP_MODE,
+                                   g_param_spec_uint ("swap-mode", NULL, NULL,
+                                                      SWAP_MODE_OCCUPANCY, SWAP_MODE_RATE, SWAP_MODE_OCCUPANCY,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
-  g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_LABEL,
-                                   g_param_spec_string ("swap-label", NULL, NULL,
-                                                        DEFAULT_LABEL[SWAP_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+  for (gint i = 0; i < N_MONITORS; i++)
+    {
+      const auto monitor = (SystemloadMonitor) i;
+      GParamSpec *pspecs[N_MONITOR_PROPERTIES];
+      const gchar *names[N_MONITOR_PROPERTIES];
 
-  g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_COLOR,
-                                   g_param_spec_boxed ("swap-color",
-                                                       NULL, NULL,
+      /* Interned strings are never freed, which satisfies G_PARAM_STATIC_STRINGS */
+      for (guint j = 0; j < N_MONITOR_PROPERTIES; j++)
+        {
+          gchar *name = g_strconcat (SETTING_NAME[monitor], "-", MONITOR_PROPERTY_NAME[j], NULL);
+          names[j] = g_intern_string (name);
+          g_free (name);
+        }
+
+      pspecs[MONITOR_PROP_ENABLED] = g_param_spec_boolean (names[MONITOR_PROP_ENABLED], NULL, NULL,
+                                                           DEFAULT_ENABLED[monitor],
+                                                           GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+      pspecs[MONITOR_PROP_USE_LABEL] = g_param_spec_boolean (names[MONITOR_PROP_USE_LABEL], NULL, NULL,
+                                                             TRUE,
+                                                             GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+      pspecs[MONITOR_PROP_LABEL] = g_param_spec_string (names[MONITOR_PROP_LABEL], NULL, NULL,
+                                                        DEFAULT_LABEL[monitor],
+                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+      pspecs[MONITOR_PROP_COLOR] = g_param_spec_boxed (names[MONITOR_PROP_COLOR], NULL, NULL,
                                                        GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+      pspecs[MONITOR_PROP_INTERVAL] = g_param_spec_uint (names[MONITOR_PROP_INTERVAL], NULL, NULL,
+                                                         0, MAX_INTERVAL, 0,
+                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+      for (guint j = 0; j < N_MONITOR_PROPERTIES; j++)
+        g_object_class_install_property (gobject_class,
+                                         monitor_property (monitor, SystemloadMonitorProperty (j)),
+                                         pspecs[j]);
+    }
 
   systemload_config_signals[CONFIGURATION_CHANGED] =
     g_signal_new (g_intern_string ("configuration-changed"),
                   G_TYPE_FROM_CLASS (gobject_class),
                   G_SIGNAL_RUN_LAST,
                   0, NULL, NULL,
-                  g_cclosure_marshal_VOID__VOID,
-                  G_TYPE_NONE, 0);
+                  NULL,
+                  G_TYPE_NONE, 2,
+                  G_TYPE_INT, G_TYPE_UINT);
 }
 
 
@@ -360,12 +457,27 @@ systemload_config_init (SystemloadConfig *config)
   config->system_monitor_command = g_strdup (DEFAULT_SYSTEM_MONITOR_COMMAND);
   config->uptime = true;
   config->uptime_label = g_strdup (DEFAULT_UPTIME_LABEL);
+  config->uptime_exclude_suspend = false;
+  config->warning_threshold = DEFAULT_WARNING_THRESHOLD;
+  config->critical_threshold = DEFAULT_CRITICAL_THRESHOLD;
+  config->display_mode = DEFAULT_DISPLAY_MODE;
+  config->adaptive = false;
+  config->adaptive_max_interval = DEFAULT_ADAPTIVE_MAX_INTERVAL;
+  config->adaptive_band = DEFAULT_ADAPTIVE_BAND;
+  config->adaptive_hold = DEFAULT_ADAPTIVE_HOLD;
+  config->timer_slack = DEFAULT_TIMER_SLACK;
+  config->cpu_peak = false;
+  config->cpu_heatmap = false;
+  config->cpu_aggregation = CPU_AGGREGATION_ALL;
+  config->memory_composition = false;
+  config->swap_mode = SWAP_MODE_OCCUPANCY;
   for (gsize i = 0; i < G_N_ELEMENTS (config->monitor); i++)
     {
-      config->monitor[i].enabled = true;
+      config->monitor[i].enabled = DEFAULT_ENABLED[i];
       config->monitor[i].use_label = true;
       config->monitor[i].label = g_strdup (DEFAULT_LABEL[i]);
       gdk_rgba_parse (&config->monitor[i].color, DEFAULT_COLOR[i]);
+      config->monitor[i].interval = 0;
     }
 }
 
@@ -388,6 +500,121 @@ systemload_config_finalize (GObject *object)
 
 
 
+static void
+get_monitor_property (const SystemloadConfig *config,
+                      guint                   prop_id,
+                      GValue                 *value)
+{
+  SystemloadMonitor monitor = prop2monitor (prop_id);
+
+  switch (prop2monitor_property (prop_id))
+    {
+    case MONITOR_PROP_ENABLED:
+      g_value_set_boolean (value, config->monitor[monitor].enabled);
+      break;
+
+    case MONITOR_PROP_USE_LABEL:
+      g_value_set_boolean (value, config->monitor[monitor].use_label);
+      break;
+
+    case MONITOR_PROP_LABEL:
+      g_value_set_string (value, config->monitor[monitor].label);
+      break;
+
+    case MONITOR_PROP_COLOR:
+      g_value_set_boxed (value, &config->monitor[monitor].color);
+      break;
+
+    case MONITOR_PROP_INTERVAL:
+      g_value_set_uint (value, config->monitor[monitor].interval);
+      break;
+
+    default:
+      break;
+    }
+}
+
+
+
+static void
+set_monitor_property (SystemloadConfig *config,
+                      guint             prop_id,
+                      const GValue     *value,
+                      GParamSpec       *pspec)
+{
+  SystemloadMonitor monitor = prop2monitor (prop_id);
+  gboolean          val_bool;
+  GdkRGBA          *val_rgba;
+  const char       *val_string;
+  guint             val_uint;
+
+  switch (prop2monitor_property (prop_id))
+    {
+    case MONITOR_PROP_ENABLED:
+      val_bool = g_value_get_boolean (value);
+      if (config->monitor[monitor].enabled != val_bool)
+        {
+          config->monitor[monitor].enabled = val_bool;
+          g_object_notify_by_pspec (G_OBJECT (config), pspec);
+          systemload_config_changed (config, monitor, SYSTEMLOAD_CHANGE_VISIBILITY);
+        }
+      break;
+
+    case MONITOR_PROP_USE_LABEL:
+      val_bool = g_value_get_boolean (value);
+      if (config->monitor[monitor].use_label != val_bool)
+        {
+          config->monitor[monitor].use_label = val_bool;
+          g_object_notify_by_pspec (G_OBJECT (config), pspec);
+          systemload_config_changed (config, monitor, SYSTEMLOAD_CHANGE_VISIBILITY);
+        }
+      break;
+
+    case MONITOR_PROP_LABEL:
+      val_string = g_value_get_string (value);
+      if (g_strcmp0 (config->monitor[monitor].label, val_string) != 0)
+        {
+          g_free (config->monitor[monitor].label);
+          config->monitor[monitor].label = g_value_dup_string (value);
+          g_object_notify_by_pspec (G_OBJECT (config), pspec);
+          systemload_config_changed (config, monitor, SYSTEMLOAD_CHANGE_LABEL);
+        }
+      break;
+
+    case MONITOR_PROP_COLOR:
+      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
+      if (!rgba_equal (config->monitor[monitor].color, *val_rgba))
+        {
+          config->monitor[monitor].color = *val_rgba;
+          g_object_notify_by_pspec (G_OBJECT (config), pspec);
+          systemload_config_changed (config, monitor, SYSTEMLOAD_CHANGE_COLOR);
+        }
+      if (is_default_color (monitor, val_rgba))
+        {
+          char *property = g_strconcat (config->property_base, "/", SETTING_NAME[monitor], "/color", NULL);
+          xfconf_channel_reset_property (config->channel, property, TRUE);
+          g_free (property);
+        }
+      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
+      break;
+
+    case MONITOR_PROP_INTERVAL:
+      val_uint = g_value_get_uint (value);
+      if (config->monitor[monitor].interval != val_uint)
+        {
+          config->monitor[monitor].interval = val_uint;
+          g_object_notify_by_pspec (G_OBJECT (config), pspec);
+          systemload_config_changed (config, monitor, SYSTEMLOAD_CHANGE_INTERVAL);
+        }
+      break;
+
+    default:
+      break;
+    }
+}
+
+
+
 static void
 systemload_config_get_property (GObject    *object,
                                 guint       _prop_id,
@@ -396,6 +623,12 @@ systemload_config_get_property (GObject    *object,
 {
   const SystemloadConfig *config = SYSTEMLOAD_CONFIG (object);
 
+  if (_prop_id >= PROP_MONITOR_FIRST)
+    {
+      get_monitor_property (config, _prop_id, value);
+      return;
+    }
+
   auto prop_id = SystemloadProperty (_prop_id);
   switch (prop_id)
     {
@@ -419,32 +652,60 @@ systemload_config_get_property (GObject    *object,
       g_value_set_string (value, config->uptime_label);
       break;
 
-    case PROP_CPU_ENABLED:
-    case PROP_MEMORY_ENABLED:
-    case PROP_NETWORK_ENABLED:
-    case PROP_SWAP_ENABLED:
-      g_value_set_boolean (value, config->monitor[prop2monitor(prop_id)].enabled);
+    case PROP_UPTIME_EXCLUDE_SUSPEND:
+      g_value_set_boolean (value, config->uptime_exclude_suspend);
+      break;
+
+    case PROP_WARNING_THRESHOLD:
+      g_value_set_uint (value, config->warning_threshold);
+      break;
+
+    case PROP_CRITICAL_THRESHOLD:
+      g_value_set_uint (value, config->critical_threshold);
+      break;
+
+    case PROP_DISPLAY_MODE:
+      g_value_set_uint (value, config->display_mode);
+      break;
+
+    case PROP_ADAPTIVE:
+      g_value_set_boolean (value, config->adaptive);
+      break;
+
+    case PROP_ADAPTIVE_MAX_INTERVAL:
+      g_value_set_uint (value, config->adaptive_max_interval);
+      break;
+
+    case PROP_ADAPTIVE_BAND:
+      g_value_set_uint (value, config->adaptive_band);
+      break;
+
+    case PROP_ADAPTIVE_HOLD:
+      g_value_set_uint (value, config->adaptive_hold);
+      break;
+
+    case PROP_TIMER_SLACK:
+      g_value_set_uint (value, config->timer_slack);
+      break;
+
+    case PROP_CPU_PEAK:
+      g_value_set_boolean (value, config->cpu_peak);
       break;
 
-    case PROP_CPU_USE_LABEL:
-    case PROP_MEMORY_USE_LABEL:
-    case PROP_NETWORK_USE_LABEL:
-    case PROP_SWAP_USE_LABEL:
-      g_value_set_boolean (value, config->monitor[prop2monitor(prop_id)].use_label);
+    case PROP_CPU_HEATMAP:
+      g_value_set_boolean (value, config->cpu_heatmap);
       break;
 
-    case PROP_CPU_LABEL:
-    case PROP_MEMORY_LABEL:
-    case PROP_NETWORK_LABEL:
-    case PROP_SWAP_LABEL:
-      g_value_set_string (value, config->monitor[prop2monitor(prop_id)].label);
+    case PROP_CPU_AGGREGATION:
+      g_value_set_uint (value, config->cpu_aggregation);
       break;
 
-    case PROP_CPU_COLOR:
-    case PROP_MEMORY_COLOR:
-    case PROP_NETWORK_COLOR:
-    case PROP_SWAP_COLOR:
-      g_value_set_boxed (value, &config->monitor[prop2monitor(prop_id)].color);
+    case PROP_MEMORY_COMPOSITION:
+      g_value_set_boolean (value, config->memory_composition);
+      break;
+
+    case PROP_SWAP_MODE:
+      g_value_set_uint (value, config->swap_mode);
       break;
 
     default:
@@ -463,10 +724,15 @@ systemload_config_set_property (GObject      *object,
 {
   SystemloadConfig *config = SYSTEMLOAD_CONFIG (object);
   gboolean          val_bool;
-  GdkRGBA          *val_rgba;
   const char       *val_string;
   guint             val_uint;
 
+  if (prop_id >= PROP_MONITOR_FIRST)
+    {
+      set_monitor_property (config, prop_id, value, pspec);
+      return;
+    }
+
   switch (prop_id)
     {
     case PROP_TIMEOUT:
@@ -475,7 +741,7 @@ systemload_config_set_property (GObject      *object,
         {
           config->timeout = val_uint;
           g_object_notify (G_OBJECT (config), "timeout");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_TIMEOUT);
         }
       break;
 
@@ -485,7 +751,7 @@ systemload_config_set_property (GObject      *object,
         {
           config->timeout_seconds = val_uint;
           g_object_notify (G_OBJECT (config), "timeout-seconds");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_TIMEOUT);
         }
       break;
 
@@ -496,7 +762,7 @@ systemload_config_set_property (GObject      *object,
           g_free (config->system_monitor_command);
           config->system_monitor_command = g_value_dup_string (value);
           g_object_notify (G_OBJECT (config), "system-monitor-command");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_COMMAND);
         }
       break;
 
@@ -506,7 +772,7 @@ systemload_config_set_property (GObject      *object,
         {
           config->uptime = val_bool;
           g_object_notify (G_OBJECT (config), "uptime-enabled");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_UPTIME);
         }
       break;
 
@@ -517,200 +783,148 @@ systemload_config_set_property (GObject      *object,
           g_free (config->uptime_label);
           config->uptime_label = g_value_dup_string (value);
           g_object_notify (G_OBJECT (config), "uptime-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_UPTIME_LABEL);
         }
       break;
 
-    case PROP_CPU_ENABLED:
+    case PROP_UPTIME_EXCLUDE_SUSPEND:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[CPU_MONITOR].enabled != val_bool)
+      if (config->uptime_exclude_suspend != val_bool)
         {
-          config->monitor[CPU_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "cpu-enabled");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->uptime_exclude_suspend = val_bool;
+          g_object_notify (G_OBJECT (config), "uptime-exclude-suspend");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_UPTIME);
         }
       break;
 
-    case PROP_CPU_USE_LABEL:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[CPU_MONITOR].use_label != val_bool)
+    case PROP_WARNING_THRESHOLD:
+      val_uint = g_value_get_uint (value);
+      if (config->warning_threshold != val_uint)
         {
-          config->monitor[CPU_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "cpu-use-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->warning_threshold = val_uint;
+          g_object_notify (G_OBJECT (config), "warning-threshold");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_THRESHOLDS);
         }
       break;
 
-    case PROP_CPU_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[CPU_MONITOR].label, val_string) != 0)
+    case PROP_CRITICAL_THRESHOLD:
+      val_uint = g_value_get_uint (value);
+      if (config->critical_threshold != val_uint)
         {
-          g_free (config->monitor[CPU_MONITOR].label);
-          config->monitor[CPU_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "cpu-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->critical_threshold = val_uint;
+          g_object_notify (G_OBJECT (config), "critical-threshold");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_THRESHOLDS);
         }
       break;
 
-    case PROP_CPU_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[CPU_MONITOR].color, *val_rgba))
-        {
-          config->monitor[CPU_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "cpu-color");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
-        }
-      if (is_default_color (CPU_MONITOR, val_rgba))
+    case PROP_DISPLAY_MODE:
+      val_uint = g_value_get_uint (value);
+      if (config->display_mode != val_uint)
         {
-          char *property = g_strconcat (config->property_base, "/cpu/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          config->display_mode = val_uint;
+          g_object_notify (G_OBJECT (config), "display-mode");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_DISPLAY_MODE);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
-    case PROP_MEMORY_ENABLED:
+    case PROP_ADAPTIVE:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[MEM_MONITOR].enabled != val_bool)
+      if (config->adaptive != val_bool)
         {
-          config->monitor[MEM_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "memory-enabled");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->adaptive = val_bool;
+          g_object_notify (G_OBJECT (config), "adaptive");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_ADAPTIVE);
         }
       break;
 
-    case PROP_MEMORY_USE_LABEL:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[MEM_MONITOR].use_label != val_bool)
+    case PROP_ADAPTIVE_MAX_INTERVAL:
+      val_uint = g_value_get_uint (value);
+      if (config->adaptive_max_interval != val_uint)
         {
-          config->monitor[MEM_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "memory-use-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->adaptive_max_interval = val_uint;
+          g_object_notify (G_OBJECT (config), "adaptive-max-interval");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_ADAPTIVE);
         }
       break;
 
-    case PROP_MEMORY_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[MEM_MONITOR].label, val_string) != 0)
+    case PROP_ADAPTIVE_BAND:
+      val_uint = g_value_get_uint (value);
+      if (config->adaptive_band != val_uint)
         {
-          g_free (config->monitor[MEM_MONITOR].label);
-          config->monitor[MEM_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "memory-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->adaptive_band = val_uint;
+          g_object_notify (G_OBJECT (config), "adaptive-band");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_ADAPTIVE);
         }
       break;
 
-    case PROP_MEMORY_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[MEM_MONITOR].color, *val_rgba))
-        {
-          config->monitor[MEM_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "memory-color");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
-        }
-      if (is_default_color (MEM_MONITOR, val_rgba))
+    case PROP_ADAPTIVE_HOLD:
+      val_uint = g_value_get_uint (value);
+      if (config->adaptive_hold != val_uint)
         {
-          char *property = g_strconcat (config->property_base, "/memory/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          config->adaptive_hold = val_uint;
+          g_object_notify (G_OBJECT (config), "adaptive-hold");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_ADAPTIVE);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
-    case PROP_NETWORK_ENABLED:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[NET_MONITOR].enabled != val_bool)
+    case PROP_TIMER_SLACK:
+      val_uint = g_value_get_uint (value);
+      if (config->timer_slack != val_uint)
         {
-          config->monitor[NET_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "network-enabled");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->timer_slack = val_uint;
+          g_object_notify (G_OBJECT (config), "timer-slack");
+          systemload_config_changed (config, -1, SYSTEMLOAD_CHANGE_TIMEOUT);
         }
       break;
 
-    case PROP_NETWORK_USE_LABEL:
+    case PROP_CPU_PEAK:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[NET_MONITOR].use_label != val_bool)
+      if (config->cpu_peak != val_bool)
         {
-          config->monitor[NET_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "network-use-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->cpu_peak = val_bool;
+          g_object_notify (G_OBJECT (config), "cpu-peak");
+          systemload_config_changed (config, CPU_MONITOR, SYSTEMLOAD_CHANGE_MARKER);
         }
       break;
 
-    case PROP_NETWORK_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[NET_MONITOR].label, val_string) != 0)
-        {
-          g_free (config->monitor[NET_MONITOR].label);
-          config->monitor[NET_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "network-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
-        }
-      break;
-
-    case PROP_NETWORK_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[NET_MONITOR].color, *val_rgba))
-        {
-          config->monitor[NET_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "network-color");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
-        }
-      if (is_default_color (NET_MONITOR, val_rgba))
-        {
-          char *property = g_strconcat (config->property_base, "/network/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
-        }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
-      break;
-
-    case PROP_SWAP_ENABLED:
+    case PROP_CPU_HEATMAP:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[SWAP_MONITOR].enabled != val_bool)
+      if (config->cpu_heatmap != val_bool)
         {
-          config->monitor[SWAP_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "swap-enabled");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->cpu_heatmap = val_bool;
+          g_object_notify (G_OBJECT (config), "cpu-heatmap");
+          systemload_config_changed (config, CPU_MONITOR, SYSTEMLOAD_CHANGE_VISIBILITY);
         }
       break;
 
-    case PROP_SWAP_USE_LABEL:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[SWAP_MONITOR].use_label != val_bool)
+    case PROP_CPU_AGGREGATION:
+      val_uint = g_value_get_uint (value);
+      if (config->cpu_aggregation != val_uint)
         {
-          config->monitor[SWAP_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "swap-use-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->cpu_aggregation = val_uint;
+          g_object_notify (G_OBJECT (config), "cpu-aggregation");
+          systemload_config_changed (config, CPU_MONITOR, SYSTEMLOAD_CHANGE_AGGREGATION);
         }
       break;
 
-    case PROP_SWAP_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[SWAP_MONITOR].label, val_string) != 0)
+    case PROP_MEMORY_COMPOSITION:
+      val_bool = g_value_get_boolean (value);
+      if (config->memory_composition != val_bool)
         {
-          g_free (config->monitor[SWAP_MONITOR].label);
-          config->monitor[SWAP_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "swap-label");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->memory_composition = val_bool;
+          g_object_notify (G_OBJECT (config), "memory-composition");
+          systemload_config_changed (config, MEM_MONITOR, SYSTEMLOAD_CHANGE_SEGMENTS);
         }
       break;
 
-    case PROP_SWAP_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[SWAP_MONITOR].color, *val_rgba))
+    case PROP_SWAP_MODE:
+      val_uint = g_value_get_uint (value);
+      if (config->swap_mode != val_uint)
         {
-          config->monitor[SWAP_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "swap-color");
-          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+          config->swap_mode = val_uint;
+          g_object_notify (G_OBJECT (config), "swap-mode");
+          systemload_config_changed (config, SWAP_MONITOR, SYSTEMLOAD_CHANGE_SWAP_MODE);
         }
-      if (is_default_color (SWAP_MONITOR, val_rgba))
-        {
-          char *property = g_strconcat (config->property_base, "/swap/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
-        }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
     default:
@@ -761,6 +975,118 @@ systemload_config_get_uptime_label (const SystemloadConfig *config)
   return config->uptime_label;
 }
 
+bool
+systemload_config_get_uptime_exclude_suspend (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->uptime_exclude_suspend;
+}
+
+guint
+systemload_config_get_warning_threshold (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_WARNING_THRESHOLD);
+
+  return config->warning_threshold;
+}
+
+guint
+systemload_config_get_critical_threshold (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_CRITICAL_THRESHOLD);
+
+  return config->critical_threshold;
+}
+
+SystemloadDisplayMode
+systemload_config_get_display_mode (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_DISPLAY_MODE);
+
+  return (SystemloadDisplayMode) config->display_mode;
+}
+
+bool
+systemload_config_get_adaptive (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->adaptive;
+}
+
+guint
+systemload_config_get_adaptive_max_interval (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ADAPTIVE_MAX_INTERVAL);
+
+  return config->adaptive_max_interval;
+}
+
+guint
+systemload_config_get_adaptive_band (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ADAPTIVE_BAND);
+
+  return config->adaptive_band;
+}
+
+guint
+systemload_config_get_adaptive_hold (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ADAPTIVE_HOLD);
+
+  return config->adaptive_hold;
+}
+
+guint
+systemload_config_get_timer_slack (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_TIMER_SLACK);
+
+  return config->timer_slack;
+}
+
+bool
+systemload_config_get_cpu_peak (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->cpu_peak;
+}
+
+bool
+systemload_config_get_cpu_heatmap (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->cpu_heatmap;
+}
+
+SystemloadCpuAggregation
+systemload_config_get_cpu_aggregation (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), CPU_AGGREGATION_ALL);
+
+  return SystemloadCpuAggregation (config->cpu_aggregation);
+}
+
+bool
+systemload_config_get_memory_composition (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->memory_composition;
+}
+
+SystemloadSwapMode
+systemload_config_get_swap_mode (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), SWAP_MODE_OCCUPANCY);
+
+  return SystemloadSwapMode (config->swap_mode);
+}
+
 bool
 systemload_config_get_enabled (const SystemloadConfig *config, SystemloadMonitor monitor)
 {
@@ -794,6 +1120,17 @@ systemload_config_get_label (const SystemloadConfig *config, SystemloadMonitor m
       return "";
 }
 
+guint
+systemload_config_get_interval (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), 0);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].interval;
+  else
+      return 0;
+}
+
 const GdkRGBA *
 systemload_config_get_color (const SystemloadConfig *config, SystemloadMonitor monitor)
 {
@@ -840,69 +1177,89 @@ systemload_config_new (const gchar *property_base)
       xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "uptime-label");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-enabled");
-      g_free (property);
-
-      property = g_strconcat (property_base, "/cpu/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-use-label");
+      property = g_strconcat (property_base, "/uptime/exclude-suspend", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "uptime-exclude-suspend");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "cpu-label");
+      property = g_strconcat (property_base, "/warning-threshold", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "warning-threshold");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "cpu-color");
+      property = g_strconcat (property_base, "/critical-threshold", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "critical-threshold");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-enabled");
+      property = g_strconcat (property_base, "/display-mode", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "display-mode");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-use-label");
+      property = g_strconcat (property_base, "/adaptive/enabled", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "adaptive");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "memory-label");
+      property = g_strconcat (property_base, "/adaptive/max-interval", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "adaptive-max-interval");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "memory-color");
+      property = g_strconcat (property_base, "/adaptive/band", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "adaptive-band");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "network-enabled");
+      property = g_strconcat (property_base, "/adaptive/hold", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "adaptive-hold");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "network-use-label");
+      property = g_strconcat (property_base, "/timer-slack", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "timer-slack");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "network-label");
+      property = g_strconcat (property_base, "/cpu/peak", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-peak");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "network-color");
+      property = g_strconcat (property_base, "/cpu/heatmap", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-heatmap");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "swap-enabled");
+      property = g_strconcat (property_base, "/cpu/aggregation", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "cpu-aggregation");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "swap-use-label");
+      property = g_strconcat (property_base, "/memory/composition", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-composition");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "swap-label");
+      property = g_strconcat (property_base, "/swap/mode", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "swap-mode");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "swap-color");
-      g_free (property);
+      for (gint i = 0; i < N_MONITORS; i++)
+        {
+          const auto monitor = (SystemloadMonitor) i;
+          for (guint j = 0; j < N_MONITOR_PROPERTIES; j++)
+            {
+              gchar *name = g_strconcat (SETTING_NAME[monitor], "-", MONITOR_PROPERTY_NAME[j], NULL);
+              property = g_strconcat (property_base, "/", SETTING_NAME[monitor], "/", MONITOR_PROPERTY_NAME[j], NULL);
+              switch (j)
+                {
+                case MONITOR_PROP_ENABLED:
+                case MONITOR_PROP_USE_LABEL:
+                  xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, name);
+                  break;
+                case MONITOR_PROP_LABEL:
+                  xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, name);
+                  break;
+                case MONITOR_PROP_COLOR:
+                  xfconf_g_property_bind_gdkrgba (channel, property, config, name);
+                  break;
+                case MONITOR_PROP_INTERVAL:
+                  xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, name);
+                  break;
+                }
+              g_free (property);
+              g_free (name);
+            }
+        }
     }
 
   return config;
@@ -911,8 +1268,11 @@ systemload_config_new (const gchar *property_base)
 
 
 void systemload_config_on_change (SystemloadConfig     *config,
-                                  gboolean             (*callback)(gpointer user_data),
+                                  void                 (*callback)(SystemloadConfig *config,
+                                                                   gint monitor,
+                                                                   guint changes,
+                                                                   gpointer user_data),
                                   gpointer             user_data)
 {
-    g_signal_connect_swapped (G_OBJECT (config), "configuration-changed", G_CALLBACK (callback), user_data);
+    g_signal_connect (G_OBJECT (config), "configuration-changed", G_CALLBACK (callback), user_data);
 }
@@ -26,11 +26,67 @@
 #define MIN_TIMEOUT 500
 #define MAX_TIMEOUT 10000
 
+/* Maximum update interval of a single monitor in milliseconds */
+#define MAX_INTERVAL 3600000
+
+/* Maximum timer slack in microseconds */
+#define MAX_TIMER_SLACK 100000
+
 enum SystemloadMonitor {
     CPU_MONITOR,
     MEM_MONITOR,
     NET_MONITOR,
     SWAP_MONITOR,
+    NUMA_MONITOR,
+    FREQ_MONITOR,
+    LOAD_MONITOR,
+    ACTIVITY_MONITOR,
+    IRQ_MONITOR,
+    RUNDELAY_MONITOR,
+    IDLE_MONITOR,
+    N_MONITORS,
+};
+
+enum SystemloadDisplayMode {
+    DISPLAY_MODE_BAR,
+    DISPLAY_MODE_BAR_AND_VALUE,
+    DISPLAY_MODE_VALUE,
+};
+
+/* What the CPU bar shows, see topology.h */
+enum SystemloadCpuAggregation {
+    CPU_AGGREGATION_ALL,
+    CPU_AGGREGATION_PHYSICAL_CORE,
+    CPU_AGGREGATION_CORE_TYPE,
+    CPU_AGGREGATION_PACKAGE,
+};
+
+/* What the swap bar shows */
+enum SystemloadSwapMode {
+    SWAP_MODE_OCCUPANCY,
+    SWAP_MODE_RATE,         /* Pages swapped in and out per second, see vmstat.h */
+};
+
+/* Flags passed to the callback of systemload_config_on_change() */
+enum SystemloadChange {
+    /* Changes not specific to a monitor (monitor == -1) */
+    SYSTEMLOAD_CHANGE_TIMEOUT      = 1 << 0,
+    SYSTEMLOAD_CHANGE_COMMAND      = 1 << 1,
+    SYSTEMLOAD_CHANGE_UPTIME       = 1 << 2,
+    SYSTEMLOAD_CHANGE_UPTIME_LABEL = 1 << 3,
+    SYSTEMLOAD_CHANGE_THRESHOLDS   = 1 << 4,
+    SYSTEMLOAD_CHANGE_DISPLAY_MODE = 1 << 5,
+    SYSTEMLOAD_CHANGE_ADAPTIVE     = 1 << 6,
+
+    /* Changes of a single monitor */
+    SYSTEMLOAD_CHANGE_VISIBILITY   = 1 << 16,
+    SYSTEMLOAD_CHANGE_LABEL        = 1 << 17,
+    SYSTEMLOAD_CHANGE_COLOR        = 1 << 18,
+    SYSTEMLOAD_CHANGE_INTERVAL     = 1 << 19,
+    SYSTEMLOAD_CHANGE_MARKER       = 1 << 20,
+    SYSTEMLOAD_CHANGE_AGGREGATION  = 1 << 21,
+    SYSTEMLOAD_CHANGE_SEGMENTS     = 1 << 22,
+    SYSTEMLOAD_CHANGE_SWAP_MODE    = 1 << 23,
 };
 
 typedef struct _SystemloadConfigClass SystemloadConfigClass;
@@ -48,7 +104,10 @@ GType              systemload_config_get_type                       (void) G_GNU
 SystemloadConfig  *systemload_config_new                            (const gchar          *property_base);
 
 void               systemload_config_on_change                      (SystemloadConfig     *config,
-                                                                     gboolean             (*callback)(gpointer user_data),
+                                                                     void                 (*callback)(SystemloadConfig *config,
+                                                                                                      gint monitor,
+                                                                                                      guint changes,
+                                                                                                      gpointer user_data),
                                                                      gpointer             user_data);
 
 guint              systemload_config_get_timeout                    (const SystemloadConfig *config);
@@ -56,10 +115,44 @@ guint              systemload_config_get_timeout_seconds            (const Syste
 const gchar       *systemload_config_get_system_monitor_command     (const SystemloadConfig *config);
 bool               systemload_config_get_uptime_enabled             (const SystemloadConfig *config);
 gchar             *systemload_config_get_uptime_label               (const SystemloadConfig *config);
+bool               systemload_config_get_uptime_exclude_suspend     (const SystemloadConfig *config);
+guint              systemload_config_get_warning_threshold          (const SystemloadConfig *config);
+guint              systemload_config_get_critical_threshold         (const SystemloadConfig *config);
+SystemloadDisplayMode systemload_config_get_display_mode            (const SystemloadConfig *config);
+
+/*
+ * Adaptive sampling: the interval of a monitor is doubled, up to the maximum
+ * interval, after hold samples in a row stayed within band percentage points,
+ * and drops back to the regular interval once a sample leaves the band.
+ */
+bool               systemload_config_get_adaptive                   (const SystemloadConfig *config);
+guint              systemload_config_get_adaptive_max_interval      (const SystemloadConfig *config);
+guint              systemload_config_get_adaptive_band              (const SystemloadConfig *config);
+guint              systemload_config_get_adaptive_hold              (const SystemloadConfig *config);
+
+/* Microseconds by which updates may be delayed to batch them into one wakeup */
+guint              systemload_config_get_timer_slack                (const SystemloadConfig *config);
+
+/* Whether the CPU monitor marks the utilization of the busiest core */
+bool               systemload_config_get_cpu_peak                   (const SystemloadConfig *config);
+
+/* Whether the CPU monitor shows a heatmap of all cores instead of a bar */
+bool               systemload_config_get_cpu_heatmap                (const SystemloadConfig *config);
+
+/* Groups of CPUs the CPU monitor averages over */
+SystemloadCpuAggregation systemload_config_get_cpu_aggregation      (const SystemloadConfig *config);
+
+/* Whether the memory monitor stacks the kinds of memory instead of showing the used memory */
+bool               systemload_config_get_memory_composition         (const SystemloadConfig *config);
+
+SystemloadSwapMode systemload_config_get_swap_mode                  (const SystemloadConfig *config);
 
 bool               systemload_config_get_enabled   (const SystemloadConfig *config, SystemloadMonitor monitor);
 bool               systemload_config_get_use_label (const SystemloadConfig *config, SystemloadMonitor monitor);
 const gchar       *systemload_config_get_label     (const SystemloadConfig *config, SystemloadMonitor monitor);
 const GdkRGBA     *systemload_config_get_color     (const SystemloadConfig *config, SystemloadMonitor monitor);
 
+/* Update interval of the monitor in milliseconds, 0 to use the global update interval */
+guint              systemload_config_get_interval  (const SystemloadConfig *config, SystemloadMonitor monitor);
+
 #endif /* _XFCE_SYSTEMLOAD_SETTINGS_H_ */
@@ -0,0 +1,249 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifdef HAVE_MALLINFO2
+#include <malloc.h>
+#endif
+
+#include "procfs.h"
+#include "scan.h"
+#include "stats.h"
+
+/* Bucket i counts durations in the range [2^i, 2^(i+1)) microseconds */
+#define N_BUCKETS 24
+
+#define LOG_INTERVAL (30 * G_USEC_PER_SEC)
+
+struct t_histogram {
+    guint64  count;
+    gint64   sum;
+    gint64   max;
+    guint64  buckets[N_BUCKETS];
+};
+
+static const gchar *const PHASE_NAME[] = {
+    "cpu",
+    "memswap",
+    "net",
+    "numa",
+    "freq",
+    "loadavg",
+    "irq",
+    "rundelay",
+    "cpuidle",
+    "vmstat",
+    "uptime",
+    "widgets",
+    "tick",
+    "late",
+};
+
+static t_histogram histograms[N_STATS_PHASES];
+static guint64 missed_ticks;
+static gint  mode = -1;   /* -1 = not initialized, bit 0 = log, bit 1 = tooltip */
+static gint64 last_log;
+
+static gint
+stats_mode ()
+{
+    if (G_UNLIKELY (mode < 0))
+    {
+        const gchar *env = g_getenv ("SYSTEMLOAD_STATS");
+        if (env == NULL || *env == '\0' || strcmp (env, "0") == 0)
+            mode = 0;
+        else if (strcmp (env, "log") == 0)
+            mode = 1;
+        else if (strcmp (env, "tooltip") == 0)
+            mode = 2;
+        else
+            mode = 3;
+    }
+    return mode;
+}
+
+bool
+stats_enabled ()
+{
+    return stats_mode () != 0;
+}
+
+bool
+stats_tooltip_enabled ()
+{
+    return (stats_mode () & 2) != 0;
+}
+
+gint64
+stats_clock ()
+{
+    return stats_enabled () ? g_get_monotonic_time () : 0;
+}
+
+void
+stats_record_value (StatsPhase phase, gint64 usec)
+{
+    if (!stats_enabled ())
+        return;
+
+    t_histogram *h = &histograms[phase];
+    if (usec < 0)
+        usec = 0;
+
+    guint bucket = 0;
+    for (gint64 v = usec >> 1; v != 0 && bucket < N_BUCKETS - 1; v >>= 1)
+        bucket++;
+
+    h->count++;
+    h->sum += usec;
+    h->buckets[bucket]++;
+    if (usec > h->max)
+        h->max = usec;
+}
+
+void
+stats_record (StatsPhase phase, gint64 *t)
+{
+    if (!stats_enabled ())
+        return;
+
+    gint64 now = g_get_monotonic_time ();
+    stats_record_value (phase, now - *t);
+    *t = now;
+}
+
+void
+stats_record_missed_ticks (guint count)
+{
+    if (stats_enabled ())
+        missed_ticks += count;
+}
+
+/* Upper bound of the bucket containing the given percentile */
+static gint64
+histogram_percentile (const t_histogram *h, guint percent)
+{
+    if (h->count == 0)
+        return 0;
+
+    guint64 target = (h->count * percent + 99) / 100;
+    guint64 seen = 0;
+    for (guint i = 0; i < N_BUCKETS; i++)
+    {
+        seen += h->buckets[i];
+        if (seen >= target)
+            return MIN ((gint64) 1 << (i + 1), h->max);
+    }
+    return h->max;
+}
+
+static gulong
+current_rss_kb (const struct rusage *usage)
+{
+#ifdef __linux__
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open ("/proc/self/statm"), &length);
+    guint64 pages[2];
+    if (contents && scan_numbers (contents, contents + length, pages, 2) == 2)
+        return pages[1] * (sysconf (_SC_PAGESIZE) / 1024);
+#endif
+#ifdef __APPLE__
+    return usage->ru_maxrss / 1024;
+#else
+    return usage->ru_maxrss;
+#endif
+}
+
+void
+stats_format (gchar *buf, gsize size)
+{
+    gsize len = 0;
+
+    buf[0] = '\0';
+    for (guint i = 0; i < N_STATS_PHASES && len < size; i++)
+    {
+        const t_histogram *h = &histograms[i];
+        if (h->count == 0)
+            continue;
+        len += g_snprintf (buf + len, size - len,
+                           "%s%s: avg %" G_GINT64_FORMAT " p50 %" G_GINT64_FORMAT
+                           " p99 %" G_GINT64_FORMAT " max %" G_GINT64_FORMAT " \302\265s",
+                           len == 0 ? "" : "\n", PHASE_NAME[i],
+                           h->sum / (gint64) h->count,
+                           histogram_percentile (h, 50),
+                           histogram_percentile (h, 99),
+                           h->max);
+    }
+
+    if (missed_ticks != 0 && len < size)
+        len += g_snprintf (buf + len, size - len, "%smissed ticks: %" G_GUINT64_FORMAT,
+                           len == 0 ? "" : "\n", missed_ticks);
+
+    if (len >= size)
+        return;
+
+    struct rusage usage;
+    if (getrusage (RUSAGE_SELF, &usage) == 0)
+    {
+        gint64 cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+                        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+        len += g_snprintf (buf + len, size - len, "%sprocess: cpu %" G_GINT64_FORMAT " ms, rss %lu KiB",
+                           len == 0 ? "" : "\n", cpu_ms, current_rss_kb (&usage));
+    }
+
+#ifdef HAVE_MALLINFO2
+    if (len < size)
+    {
+        struct mallinfo2 mi = mallinfo2 ();
+        g_snprintf (buf + len, size - len, ", heap %" G_GSIZE_FORMAT " KiB",
+                    (gsize) ((mi.uordblks + mi.hblkhd) / 1024));
+    }
+#endif
+}
+
+void
+stats_maybe_log ()
+{
+    if (!(stats_mode () & 1))
+        return;
+
+    gint64 now = g_get_monotonic_time ();
+    if (last_log == 0)
+        last_log = now;
+    if (now - last_log < LOG_INTERVAL)
+        return;
+    last_log = now;
+
+    gchar buf[1024];
+    stats_format (buf, sizeof (buf));
+    g_message ("Statistics:\n%s", buf);
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_STATS_H_
+#define _XFCE_SYSTEMLOAD_STATS_H_
+
+#include <glib.h>
+
+/*
+ * Self-instrumentation of the plugin. Enabled by setting the environment
+ * variable SYSTEMLOAD_STATS before the panel starts:
+ *
+ *   SYSTEMLOAD_STATS=log      periodic summary via g_message()
+ *   SYSTEMLOAD_STATS=tooltip  summary appended to the monitor tooltips
+ *   SYSTEMLOAD_STATS=1        both
+ *
+ * All samples are kept in fixed-size histograms, recording never allocates.
+ */
+
+enum StatsPhase {
+    STATS_READ_CPU,
+    STATS_READ_MEMSWAP,
+    STATS_READ_NET,
+    STATS_READ_NUMA,
+    STATS_READ_FREQ,
+    STATS_READ_LOAD,
+    STATS_READ_IRQ,
+    STATS_READ_RUNDELAY,
+    STATS_READ_IDLE,
+    STATS_READ_VMSTAT,
+    STATS_READ_UPTIME,
+    STATS_WIDGETS,
+    STATS_TICK,
+    STATS_LATENESS,
+    N_STATS_PHASES,
+};
+
+bool     stats_enabled         ();
+bool     stats_tooltip_enabled ();
+
+/* Returns the current monotonic time in microseconds, or 0 if statistics are disabled */
+gint64   stats_clock           ();
+
+/* Records the time elapsed since *t and advances *t to the current time */
+void     stats_record          (StatsPhase phase, gint64 *t);
+
+/* Records an already measured duration */
+void     stats_record_value    (StatsPhase phase, gint64 usec);
+
+/* Counts updates that were skipped because the main loop woke up too late */
+void     stats_record_missed_ticks (guint count);
+
+/* Formats a multi-line summary of all histograms and of the plugin's resource usage */
+void     stats_format          (gchar *buf, gsize size);
+
+/* Emits the summary via g_message() if logging is enabled and the log interval elapsed */
+void     stats_maybe_log       ();
+
+#endif /* _XFCE_SYSTEMLOAD_STATS_H_ */
@@ -34,8 +34,6 @@
 #include "xfce-revision.h"
 #endif
 
-#include <string>
-
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -55,12 +53,27 @@
 #include <glibtop.h>
 #endif
 
+#include "bar.h"
 #include "cpu.h"
+#include "cpufreq.h"
+#include "cpuidle.h"
+#include "heatmap.h"
+#include "irq.h"
+#include "loadavg.h"
 #include "memswap.h"
 #include "network.h"
+#include "numa.h"
 #include "plugin.h"
+#include "procfs.h"
+#include "schedstat.h"
+#include "scheduler.h"
 #include "settings.h"
+#include "stats.h"
+#include "topology.h"
+#include "trace.h"
 #include "uptime.h"
+#include "value.h"
+#include "vmstat.h"
 
 
 
@@ -73,16 +86,27 @@ struct t_monitor {
     GtkWidget  *box;
     GtkWidget  *label;
     GtkWidget  *status;
+    GtkWidget  *heatmap;   /* Only for the CPU monitor */
+    GtkWidget  *value;
     GtkWidget  *ebox;
 
     gulong     value_read; /* Range: 0% ... 100% */
+    guint      severity;   /* Index into SEVERITY_CLASS */
+
+    /* Milliseconds, 0 if disabled. interval is longer than base_interval while adaptive sampling slows down. */
+    guint      base_interval;
+    guint      interval;
+    gulong     reference_value;
+    guint      stable_samples;
 };
 
 struct t_uptime_monitor {
-    GtkWidget  *label;
-    GtkWidget  *ebox;
+    GtkWidget         *label;
+    GtkWidget         *ebox;
 
-    gulong     value_read;
+    gulong            value_read;
+    t_uptime_format  *format;
+    guint             timeout_id;
 };
 
 struct t_global_monitor {
@@ -91,11 +115,15 @@ struct t_global_monitor {
     GtkWidget         *settings_dialog;
     GtkWidget         *ebox;
     GtkWidget         *box;
+    GtkCssProvider    *css_provider;
     guint             timeout, timeout_seconds;
     bool              use_timeout_seconds;
-    guint             timeout_id;
+    t_scheduler       *scheduler;
     t_command         command;
-    t_monitor         *monitor[4];
+    t_monitor         *monitor[N_MONITORS];
+    guint             pending_changes[N_MONITORS];
+    guint             pending_global_changes;
+    guint             apply_changes_id;
     t_uptime_monitor  uptime;
 #ifdef HAVE_UPOWER_GLIB
     UpClient          *upower;
@@ -106,12 +134,84 @@ struct t_global_monitor {
 
 static const SystemloadMonitor VISUAL_ORDER[] = {
     CPU_MONITOR,
+    FREQ_MONITOR,
+    LOAD_MONITOR,
+    ACTIVITY_MONITOR,
+    IRQ_MONITOR,
+    RUNDELAY_MONITOR,
+    IDLE_MONITOR,
     MEM_MONITOR,
     SWAP_MONITOR,
     NET_MONITOR,
+    NUMA_MONITOR,
+};
+
+/* Masks of monitors passed to update_monitors() have the bit 1 << SystemloadMonitor set */
+#define ALL_MONITORS ((1u << G_N_ELEMENTS (VISUAL_ORDER)) - 1)
+
+/* Style classes of the bars, used by the stylesheet built in setup_stylesheet() */
+static const gchar *const CSS_CLASS[] = {
+    "cpu",
+    "memory",
+    "network",
+    "swap",
+    "numa",
+    "frequency",
+    "loadavg",
+    "activity",
+    "interrupts",
+    "rundelay",
+    "cpuidle",
 };
 
-static gboolean setup_monitor_cb(gpointer user_data);
+enum {
+    SEVERITY_NORMAL,
+    SEVERITY_WARNING,
+    SEVERITY_CRITICAL,
+};
+
+static const gchar *const SEVERITY_CLASS[] = {
+    NULL,
+    "warning",
+    "critical",
+};
+
+static const gchar *const SEVERITY_COLOR[] = {
+    NULL,
+    "#e5a50a",
+    "#e01b24",
+};
+
+/* Colors of the memory composition following the anonymous memory, which has the color of the monitor */
+static const GdkRGBA MEMORY_SEGMENT_COLORS[] = {
+    { 0.569, 0.255, 0.675, 1 },   /* Shmem, #9141ac */
+    { 0.753, 0.110, 0.157, 1 },   /* Kernel stacks and page tables, #c01c28 */
+    { 0.902, 0.380, 0.000, 1 },   /* Unreclaimable slab, #e66100 */
+    { 0.965, 0.827, 0.176, 1 },   /* Reclaimable slab, #f6d32d */
+    { 0.208, 0.518, 0.894, 1 },   /* Dirty and writeback, #3584e4 */
+    { 0.604, 0.600, 0.588, 1 },   /* Page cache, #9a9996 */
+};
+
+/* Pages swapped in and out per second that fill the swap bar in SWAP_MODE_RATE, 10 MiB/s of 4 KiB pages */
+#define SWAP_RATE_FULL 2560
+
+/* Fork rate per second that fills the bar of the activity monitor */
+#define FORK_STORM_RATE 1000
+
+/* Runqueue wait per timeslice in microseconds that fills the bar of the run delay monitor */
+#define RUN_DELAY_FULL 10000
+
+/* Fixed thresholds of the activity monitor, 100 is a D-state pileup or a fork storm */
+#define ACTIVITY_WARNING 50
+#define ACTIVITY_CRITICAL 100
+
+G_STATIC_ASSERT (CPU_CORE_NO_DATA == SYSTEMLOAD_HEATMAP_NO_VALUE);
+
+static void configuration_changed_cb(SystemloadConfig *config, gint monitor, guint changes, gpointer user_data);
+static void update_monitors_cb(guint32 due, gpointer user_data);
+
+/* Summary of the self-instrumentation, appended to tooltips if enabled */
+static gchar stats_text[1024];
 
 
 
@@ -133,159 +233,593 @@ click_event(GtkWidget *w, GdkEventButton *event, t_global_monitor *global)
 }
 
 static void
-set_fraction(GtkProgressBar *bar, gdouble fraction)
+set_fraction(GtkWidget *bar, gdouble fraction)
 {
-    /*
-     * Try to avoid a call to GTK's bar_set_fraction() if the new fraction
-     * isn't changing the number of pixels (height or width of the bar) already
-     * displayed on the screen.
-     *
-     * max_alloc is independent from horizontal/vertical orientation of the bar.
-     */
+    /* The bar ignores updates that don't change any pixel on the screen */
+    TRACE_SCOPE ("set_fraction");
+    systemload_bar_set_fraction (SYSTEMLOAD_BAR (bar), fraction);
+}
 
-    GtkAllocation alloc;
-    gtk_widget_get_allocation(GTK_WIDGET(bar), &alloc);
+/*
+ * Recolors the bar by toggling a style class of the shared stylesheet,
+ * which doesn't involve any CSS parsing.
+ */
+static void
+set_severity(const t_global_monitor *global, t_monitor *m, gulong value)
+{
+    guint warning = systemload_config_get_warning_threshold (global->config);
+    guint critical = systemload_config_get_critical_threshold (global->config);
+    guint severity = SEVERITY_NORMAL;
 
-    gint max_alloc = MAX(alloc.width, alloc.height);
-    if (max_alloc > 1)
-        fraction = round(fraction * max_alloc) / max_alloc;
+    if (m == global->monitor[ACTIVITY_MONITOR])
+    {
+        warning = ACTIVITY_WARNING;
+        critical = ACTIVITY_CRITICAL;
+    }
 
-    if (gtk_progress_bar_get_fraction(bar) != fraction)
-        gtk_progress_bar_set_fraction(bar, fraction);
+    if (critical != 0 && value >= critical)
+        severity = SEVERITY_CRITICAL;
+    else if (warning != 0 && value >= warning)
+        severity = SEVERITY_WARNING;
+
+    if (m->severity != severity)
+    {
+        GtkStyleContext *context = gtk_widget_get_style_context (m->status);
+        if (SEVERITY_CLASS[m->severity])
+            gtk_style_context_remove_class (context, SEVERITY_CLASS[m->severity]);
+        if (SEVERITY_CLASS[severity])
+            gtk_style_context_add_class (context, SEVERITY_CLASS[severity]);
+        m->severity = severity;
+    }
 }
 
 static void
 set_label_text(GtkLabel *label, const gchar *text)
 {
+    TRACE_SCOPE ("set_label_text");
     const gchar *displayed_text = gtk_label_get_text(label);
     if (g_strcmp0(displayed_text, text) != 0)
         gtk_label_set_text(label, text);
 }
 
-static void
-date_format(std::string& format_string, const gchar* replace_str, std::string value_str)
-{
-    size_t pos = 0;
-    pos = format_string.find(replace_str, pos);
-    while (pos != std::string::npos)
-    {
-        format_string.replace(pos, 2, value_str);
-        pos = format_string.find(replace_str, pos);
-    }
-}
-
 static void
 set_tooltip(GtkWidget *w, const gchar *caption)
 {
+    TRACE_SCOPE ("set_tooltip");
+    gchar *caption_with_stats = NULL;
+    if (G_UNLIKELY (stats_tooltip_enabled ()))
+        caption = caption_with_stats = g_strconcat (caption, "\n\n", stats_text, NULL);
+
     gchar *displayed_caption = gtk_widget_get_tooltip_text(w);
     if (g_strcmp0(displayed_caption, caption) != 0)
         gtk_widget_set_tooltip_text(w, caption);
     g_free(displayed_caption);
+    g_free(caption_with_stats);
+}
+
+static bool
+monitor_due(const SystemloadConfig *config, guint due, SystemloadMonitor monitor)
+{
+    return (due & (1u << monitor)) != 0 && systemload_config_get_enabled (config, monitor);
 }
 
+/* Reads and displays the monitors in the mask due, see ALL_MONITORS */
 static void
-update_monitors(t_global_monitor *global)
+update_monitors(t_global_monitor *global, guint due)
 {
     const SystemloadConfig *config = global->config;
     gulong MTotal = 0, MUsed = 0, NTotal = 0, STotal = 0, SUsed = 0;
+    gint cpu_peak = -1;
+    t_numa_node numa_nodes[NUMA_MAX_NODES];
+    guint n_numa_nodes = 0;
+    t_cpufreq cpufreq;
+    gint cpufreq_status = -1;
+    t_loadavg loadavg;
+    gint loadavg_status = -1;
+    t_cpu_activity activity;
+    t_mem_composition composition;
+    bool show_composition = false;
+    t_vmstat vmstat;
+    gint vmstat_status = -1;
+    t_irq_stats irqs;
+    gint irq_status = -1;
+    t_schedstat schedstat;
+    gint schedstat_status = -1;
+    t_cpuidle cpuidle;
+    gint cpuidle_status = -1;
+    const bool activity_due = monitor_due (config, due, ACTIVITY_MONITOR);
+    const bool numa_due = monitor_due (config, due, NUMA_MONITOR);
+    const bool show_peak = systemload_config_get_cpu_peak (config);
+    const bool show_heatmap = systemload_config_get_cpu_heatmap (config);
+    const SystemloadCpuAggregation aggregation = systemload_config_get_cpu_aggregation (config);
+    t_cpu_group cpu_groups[TOPOLOGY_MAX_GROUPS];
+    guint n_cpu_groups = 0;
+
+    TRACE_SCOPE ("update_monitors");
 
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
-        global->monitor[i]->value_read = 0;
+        if (due & (1u << i))
+            global->monitor[i]->value_read = 0;
+
+    /* Each monitor is a reader of the procfs files, batch the reads of all due monitors */
+    procfs_prefetch (due);
+
+    gint64 t = stats_clock ();
 
-    if (systemload_config_get_enabled (config, CPU_MONITOR))
-        global->monitor[CPU_MONITOR]->value_read = read_cpuload();
-    if (systemload_config_get_enabled (config, MEM_MONITOR) ||
-        systemload_config_get_enabled (config, SWAP_MONITOR))
+    /*
+     * The activity monitor needs the lines following the CPUs in /proc/stat.
+     * They come from the same read when the CPU monitor is due, otherwise the
+     * snapshots of the CPU loads must not move on.
+     */
+    if (activity_due && !monitor_due (config, due, CPU_MONITOR))
+    {
+        TRACE_SCOPE ("read_cpu_activity");
+        procfs_set_reader (1u << ACTIVITY_MONITOR);
+        read_cpu_activity (&activity);
+        stats_record (STATS_READ_CPU, &t);
+    }
+    if (monitor_due (config, due, CPU_MONITOR))
+    {
+        TRACE_SCOPE ("read_cpuload");
+        procfs_set_reader ((1u << CPU_MONITOR) | (1u << ACTIVITY_MONITOR));
+        /* The busiest core comes from the same pass over /proc/stat */
+        const bool per_core = show_peak || show_heatmap || aggregation != CPU_AGGREGATION_ALL;
+        global->monitor[CPU_MONITOR]->value_read = read_cpuload(per_core ? &cpu_peak : NULL,
+                                                                activity_due ? &activity : NULL);
+        if (aggregation != CPU_AGGREGATION_ALL)
+        {
+            const guint8 *loads;
+            guint n_cores = read_cpuload_cores (&loads);
+            n_cpu_groups = topology_aggregate (aggregation, loads, n_cores, cpu_groups, G_N_ELEMENTS (cpu_groups));
+
+            /* The bar shows the busiest group */
+            if (n_cpu_groups != 0)
+            {
+                guint load = 0;
+                for (guint i = 0; i < n_cpu_groups; i++)
+                    load = MAX (load, cpu_groups[i].load);
+                global->monitor[CPU_MONITOR]->value_read = load;
+            }
+        }
+        stats_record (STATS_READ_CPU, &t);
+    }
+    if (activity_due && activity.valid)
     {
+        gulong blocked = activity.blocked * 100 / activity.n_cpus;
+        gulong forks = (gulong) (activity.forks * 100 / FORK_STORM_RATE);
+        global->monitor[ACTIVITY_MONITOR]->value_read = MAX (blocked, forks);
+    }
+    if (monitor_due (config, due, MEM_MONITOR) ||
+        monitor_due (config, due, SWAP_MONITOR))
+    {
+        TRACE_SCOPE ("read_memswap");
+        procfs_set_reader ((1u << MEM_MONITOR) | (1u << SWAP_MONITOR));
         gulong mem, swap;
         if (read_memswap(&mem, &swap, &MTotal, &MUsed, &STotal, &SUsed) == 0)
         {
             global->monitor[MEM_MONITOR]->value_read = mem;
             global->monitor[SWAP_MONITOR]->value_read = swap;
+            show_composition = systemload_config_get_memory_composition (config) &&
+                               read_memswap_composition (&composition) && composition.total != 0;
         }
+        stats_record (STATS_READ_MEMSWAP, &t);
+    }
+    if (monitor_due (config, due, SWAP_MONITOR))
+    {
+        TRACE_SCOPE ("read_vmstat");
+        procfs_set_reader (1u << SWAP_MONITOR);
+        vmstat_status = read_vmstat (&vmstat);
+        /* Paging tells thrashing apart from swap that merely holds cold pages */
+        if (systemload_config_get_swap_mode (config) == SWAP_MODE_RATE)
+            global->monitor[SWAP_MONITOR]->value_read =
+                vmstat_status == 0 ? (gulong) round ((vmstat.swap_in + vmstat.swap_out) * 100 / SWAP_RATE_FULL) : 0;
+        stats_record (STATS_READ_VMSTAT, &t);
     }
-    if (systemload_config_get_enabled (config, NET_MONITOR))
+    if (monitor_due (config, due, NET_MONITOR))
     {
+        TRACE_SCOPE ("read_netload");
+        procfs_set_reader (1u << NET_MONITOR);
         gulong net;
         if (read_netload (&net, &NTotal) == 0)
             global->monitor[NET_MONITOR]->value_read = net;
+        stats_record (STATS_READ_NET, &t);
     }
-    if (systemload_config_get_uptime_enabled (config))
-        global->uptime.value_read = read_uptime();
+    if (monitor_due (config, due, FREQ_MONITOR))
+    {
+        TRACE_SCOPE ("read_cpufreq");
+        procfs_set_reader (1u << FREQ_MONITOR);
+        cpufreq_status = read_cpufreq (&cpufreq);
+        if (cpufreq_status == 0)
+            global->monitor[FREQ_MONITOR]->value_read = cpufreq.avg;
+        stats_record (STATS_READ_FREQ, &t);
+    }
+    if (monitor_due (config, due, LOAD_MONITOR))
+    {
+        TRACE_SCOPE ("read_loadavg");
+        procfs_set_reader (1u << LOAD_MONITOR);
+        loadavg_status = read_loadavg (&loadavg);
+        /* A full bar means one runnable task per online CPU */
+        if (loadavg_status == 0)
+            global->monitor[LOAD_MONITOR]->value_read = (gulong) round (loadavg.load[0] * 100 / loadavg.n_cpus);
+        stats_record (STATS_READ_LOAD, &t);
+    }
+    if (monitor_due (config, due, IRQ_MONITOR))
+    {
+        TRACE_SCOPE ("read_irqs");
+        procfs_set_reader (1u << IRQ_MONITOR);
+        irq_status = read_irqs (&irqs);
+        /* An empty bar means evenly spread interrupts, a full bar all of them on one CPU */
+        if (irq_status == 0 && irqs.n_cpus > 1)
+            global->monitor[IRQ_MONITOR]->value_read = (gulong) round ((irqs.imbalance - 1) * 100 / (irqs.n_cpus - 1));
+        stats_record (STATS_READ_IRQ, &t);
+    }
+    if (monitor_due (config, due, RUNDELAY_MONITOR))
+    {
+        TRACE_SCOPE ("read_schedstat");
+        procfs_set_reader (1u << RUNDELAY_MONITOR);
+        schedstat_status = read_schedstat (&schedstat);
+        if (schedstat_status == 0)
+            global->monitor[RUNDELAY_MONITOR]->value_read = (gulong) round (schedstat.wait_per_slice * 100 / RUN_DELAY_FULL);
+        stats_record (STATS_READ_RUNDELAY, &t);
+    }
+    if (monitor_due (config, due, IDLE_MONITOR))
+    {
+        TRACE_SCOPE ("read_cpuidle");
+        procfs_set_reader (1u << IDLE_MONITOR);
+        cpuidle_status = read_cpuidle (&cpuidle);
+        /* The value is the share of time in the deepest state */
+        if (cpuidle_status == 0)
+        {
+            gdouble deepest = 0;
+            guint n_cpus = 0;
+            for (guint i = 0; i < cpuidle.n_packages; i++)
+            {
+                deepest += cpuidle.packages[i].residency[cpuidle.n_states - 1] * cpuidle.packages[i].n_cpus;
+                n_cpus += cpuidle.packages[i].n_cpus;
+            }
+            if (n_cpus != 0)
+                global->monitor[IDLE_MONITOR]->value_read = (gulong) round (deepest * 100 / n_cpus);
+        }
+        stats_record (STATS_READ_IDLE, &t);
+    }
+    if (numa_due)
+    {
+        TRACE_SCOPE ("read_numa");
+        procfs_set_reader (1u << NUMA_MONITOR);
+        n_numa_nodes = read_numa (numa_nodes, G_N_ELEMENTS (numa_nodes));
+
+        /* The bar shows the fullest node */
+        for (guint i = 0; i < n_numa_nodes; i++)
+            global->monitor[NUMA_MONITOR]->value_read = MAX (global->monitor[NUMA_MONITOR]->value_read,
+                                                             numa_nodes[i].mem_used * 100 / numa_nodes[i].mem_total);
+        stats_record (STATS_READ_NUMA, &t);
+    }
+    procfs_set_reader (0);
+
+    if (G_UNLIKELY (stats_tooltip_enabled ()))
+    {
+        stats_format (stats_text, sizeof (stats_text));
+        t = stats_clock ();
+    }
+
+    SystemloadDisplayMode display_mode = systemload_config_get_display_mode (config);
 
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
     {
         const auto monitor = (SystemloadMonitor) i;
         t_monitor *m = global->monitor[monitor];
 
-        if (systemload_config_get_enabled (config, monitor))
+        if (monitor_due (config, due, monitor))
         {
             gulong value = MIN(m->value_read, 100);
-            set_fraction(GTK_PROGRESS_BAR(global->monitor[i]->status), value / 100.0);
+            /* The idle state monitor and the memory composition have several segments, set below */
+            if (monitor != IDLE_MONITOR && !(monitor == MEM_MONITOR && show_composition))
+                set_fraction(global->monitor[i]->status, value / 100.0);
+            /* A high clock is what the CPUs should run at, a deep sleep what idle CPUs should do */
+            if (monitor != FREQ_MONITOR && monitor != IDLE_MONITOR)
+                set_severity(global, m, value);
+
+            /* Cached strings, an unchanged value doesn't even touch the widget */
+            if (display_mode != DISPLAY_MODE_BAR)
+                systemload_value_set_text (SYSTEMLOAD_VALUE (m->value),
+                                           (monitor == NET_MONITOR) ? systemload_value_format_rate (NTotal)
+                                                                    : systemload_value_format_percent (value));
         }
     }
 
-    if (systemload_config_get_enabled (config, CPU_MONITOR))
+    if (monitor_due (config, due, CPU_MONITOR))
     {
-        gchar tooltip[128];
-        g_snprintf(tooltip, sizeof(tooltip), _("System Load: %ld%%"), global->monitor[CPU_MONITOR]->value_read);
+        gchar tooltip[128 + TOPOLOGY_MAX_GROUPS * 48];
+        if (!show_peak)
+            cpu_peak = -1;
+        systemload_bar_set_marker (SYSTEMLOAD_BAR (global->monitor[CPU_MONITOR]->status),
+                                   cpu_peak >= 0 ? cpu_peak / 100.0 : -1);
+        if (show_heatmap)
+        {
+            const guint8 *loads;
+            guint n_cores = read_cpuload_cores (&loads);
+            systemload_heatmap_set_values (SYSTEMLOAD_HEATMAP (global->monitor[CPU_MONITOR]->heatmap), loads, n_cores);
+        }
+        if (cpu_peak >= 0)
+            g_snprintf(tooltip, sizeof(tooltip), _("System Load: %ld%%\nBusiest core: %d%%"),
+                       global->monitor[CPU_MONITOR]->value_read, cpu_peak);
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("System Load: %ld%%"), global->monitor[CPU_MONITOR]->value_read);
+        for (guint i = 0; i < n_cpu_groups; i++)
+        {
+            gsize len = strlen (tooltip);
+            g_snprintf(tooltip + len, sizeof(tooltip) - len, "\n%s: %u%%", cpu_groups[i].name, cpu_groups[i].load);
+        }
         set_tooltip(global->monitor[CPU_MONITOR]->ebox, tooltip);
     }
 
-    if (systemload_config_get_enabled (config, MEM_MONITOR))
+    if (monitor_due (config, due, MEM_MONITOR))
     {
-        gchar tooltip[128];
-        g_snprintf(tooltip, sizeof(tooltip), _("Memory: %ldMB of %ldMB used"), MUsed >> 10 , MTotal >> 10);
+        gchar tooltip[512];
+        gint len = g_snprintf(tooltip, sizeof(tooltip), _("Memory: %ldMB of %ldMB used"), MUsed >> 10 , MTotal >> 10);
+        if (show_composition)
+        {
+            const gulong parts[] = {
+                composition.anon, composition.shmem, composition.kernel, composition.slab_unreclaimable,
+                composition.slab_reclaimable, composition.dirty, composition.page_cache,
+            };
+            gdouble fractions[G_N_ELEMENTS (parts)];
+            for (guint i = 0; i < G_N_ELEMENTS (parts); i++)
+                fractions[i] = (gdouble) parts[i] / composition.total;
+
+            SystemloadBar *bar = SYSTEMLOAD_BAR (global->monitor[MEM_MONITOR]->status);
+            systemload_bar_set_segment_colors (bar, MEMORY_SEGMENT_COLORS, G_N_ELEMENTS (MEMORY_SEGMENT_COLORS));
+            systemload_bar_set_segments (bar, fractions, G_N_ELEMENTS (fractions));
+
+            if ((gsize) len < sizeof(tooltip))
+                g_snprintf(tooltip + len, sizeof(tooltip) - len,
+                           _("\nAnonymous: %luMB\nShared memory and tmpfs: %luMB\nKernel stacks and page tables: %luMB"
+                             "\nSlab: %luMB unreclaimable, %luMB reclaimable\nDirty and writeback: %luMB\nPage cache: %luMB"),
+                           composition.anon >> 10, composition.shmem >> 10, composition.kernel >> 10,
+                           composition.slab_unreclaimable >> 10, composition.slab_reclaimable >> 10,
+                           composition.dirty >> 10, composition.page_cache >> 10);
+        }
         set_tooltip(global->monitor[MEM_MONITOR]->ebox, tooltip);
     }
 
-    if (systemload_config_get_enabled (config, NET_MONITOR))
+    if (monitor_due (config, due, NET_MONITOR))
     {
         gchar tooltip[128];
         g_snprintf(tooltip, sizeof(tooltip), _("Network: %ld Mbit/s"), (glong) round (NTotal / 1e6));
         set_tooltip(global->monitor[NET_MONITOR]->ebox, tooltip);
     }
 
-    if (systemload_config_get_enabled (config, SWAP_MONITOR))
+    if (monitor_due (config, due, SWAP_MONITOR))
     {
-        gchar tooltip[128];
+        gchar tooltip[384];
+        gint len;
 
         if (STotal)
-            g_snprintf(tooltip, sizeof(tooltip), _("Swap: %ldMB of %ldMB used"), SUsed >> 10, STotal >> 10);
+            len = g_snprintf(tooltip, sizeof(tooltip), _("Swap: %ldMB of %ldMB used"), SUsed >> 10, STotal >> 10);
         else
-            g_snprintf(tooltip, sizeof(tooltip), _("No swap"));
+            len = g_snprintf(tooltip, sizeof(tooltip), _("No swap"));
+        if (vmstat_status == 0 && (gsize) len < sizeof(tooltip))
+            len += g_snprintf(tooltip + len, sizeof(tooltip) - len,
+                              _("\nSwapped in: %.0f pages/s\nSwapped out: %.0f pages/s\nMajor faults: %.0f/s"
+                                "\nRefaults: %.0f/s\nAllocation stalls: %.0f/s"),
+                              vmstat.swap_in, vmstat.swap_out, vmstat.major_faults, vmstat.refaults,
+                              vmstat.alloc_stalls);
+        if (vmstat_status == 0 && vmstat.oom_kills != 0 && (gsize) len < sizeof(tooltip))
+            g_snprintf(tooltip + len, sizeof(tooltip) - len, _("\nOOM kills: %lu"), (gulong) vmstat.oom_kills);
 
         set_tooltip(global->monitor[SWAP_MONITOR]->ebox, tooltip);
     }
 
-    if (systemload_config_get_uptime_enabled (config))
+    if (monitor_due (config, due, FREQ_MONITOR))
     {
-        gchar days_str[32], hours_str[32], mins_str[32];
-        gchar tooltip[128];
+        gchar tooltip[256];
+
+        systemload_bar_set_marker (SYSTEMLOAD_BAR (global->monitor[FREQ_MONITOR]->status),
+                                   cpufreq_status == 0 ? cpufreq.min / 100.0 : -1);
+        if (cpufreq_status == 0)
+            g_snprintf(tooltip, sizeof(tooltip),
+                       _("Frequency: %.2f GHz average (%u%%), %.2f GHz slowest CPU (%u%%)\nThrottle events: %lu"),
+                       cpufreq.avg_khz / 1e6, cpufreq.avg, cpufreq.min_khz / 1e6, cpufreq.min,
+                       (gulong) cpufreq.throttle_events);
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No frequency information"));
+        set_tooltip(global->monitor[FREQ_MONITOR]->ebox, tooltip);
+    }
 
-        const gchar* format = systemload_config_get_uptime_label(config);
-        std::string formatted_date = format;
+    if (monitor_due (config, due, LOAD_MONITOR))
+    {
+        gchar tooltip[256];
 
-        gint days = global->uptime.value_read / 86400;
-        gint hours = (global->uptime.value_read / 3600) % 24;
-        gint mins = (global->uptime.value_read / 60) % 60;
-        gint secs = (global->uptime.value_read) % 60;
+        if (loadavg_status == 0)
+        {
+            const gdouble n = loadavg.n_cpus;
+            gint len = g_snprintf(tooltip, sizeof(tooltip),
+                                  _("Load average: %.2f, %.2f, %.2f\nPer CPU: %.2f, %.2f, %.2f"),
+                                  loadavg.load[0], loadavg.load[1], loadavg.load[2],
+                                  loadavg.load[0] / n, loadavg.load[1] / n, loadavg.load[2] / n);
+            if (loadavg.total != 0 && (gsize) len < sizeof(tooltip))
+                g_snprintf(tooltip + len, sizeof(tooltip) - len, _("\nTasks: %u running of %u"),
+                           loadavg.running, loadavg.total);
+        }
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No load average"));
+        set_tooltip(global->monitor[LOAD_MONITOR]->ebox, tooltip);
+    }
 
-        date_format(formatted_date, "%d", std::to_string(days));
-        date_format(formatted_date, "%h", std::to_string(hours));
-        date_format(formatted_date, "%m", std::to_string(mins));
-        date_format(formatted_date, "%s", std::to_string(secs));
+    if (activity_due)
+    {
+        gchar tooltip[384];
 
-        set_label_text(GTK_LABEL(global->uptime.label), formatted_date.c_str());
+        if (activity.valid)
+        {
+            gint len = g_snprintf(tooltip, sizeof(tooltip),
+                                  _("Context switches: %.0f/s\nInterrupts: %.0f/s\nForks: %.0f/s\nTasks: %u running, %u blocked"),
+                                  activity.context_switches, activity.interrupts, activity.forks,
+                                  activity.running, activity.blocked);
+            if (activity.blocked >= activity.n_cpus && (gsize) len < sizeof(tooltip))
+                len += g_snprintf(tooltip + len, sizeof(tooltip) - len, "\n%s",
+                                  _("More tasks blocked in uninterruptible sleep than CPUs"));
+            if (activity.forks >= FORK_STORM_RATE && (gsize) len < sizeof(tooltip))
+                g_snprintf(tooltip + len, sizeof(tooltip) - len, "\n%s", _("Fork storm"));
+        }
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No scheduler activity information"));
+        set_tooltip(global->monitor[ACTIVITY_MONITOR]->ebox, tooltip);
+    }
 
-        // Tooltip text
-        g_snprintf(days_str, sizeof(days_str), ngettext("%d day", "%d days", days), days);
-        g_snprintf(hours_str, sizeof(hours_str), ngettext("%d hour", "%d hours", hours), hours);
-        g_snprintf(mins_str, sizeof(mins_str), ngettext("%d minute", "%d minutes", mins), mins);
+    if (monitor_due (config, due, IRQ_MONITOR))
+    {
+        gchar tooltip[256 + IRQ_TOP_SOURCES * 64];
 
-        g_snprintf(tooltip, sizeof(tooltip), _("Uptime: %s, %s, %s"), days_str, hours_str, mins_str);
-        set_tooltip(global->uptime.ebox, tooltip);
+        if (irq_status == 0)
+        {
+            gint len = g_snprintf(tooltip, sizeof(tooltip),
+                                  _("Interrupts: %.0f/s\nSoftirqs: %.0f/s\nHottest CPU %u: %.0f/s, %.1f\303\227 the mean"),
+                                  irqs.irq_rate, irqs.softirq_rate, irqs.hottest_cpu, irqs.hottest_rate,
+                                  irqs.imbalance);
+            for (guint i = 0; i < irqs.n_top && (gsize) len < sizeof(tooltip); i++)
+                len += g_snprintf(tooltip + len, sizeof(tooltip) - len, "\n%s: %.0f/s",
+                                  irqs.top[i].name, irqs.top[i].rate);
+        }
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No interrupt information"));
+        set_tooltip(global->monitor[IRQ_MONITOR]->ebox, tooltip);
     }
+
+    if (monitor_due (config, due, RUNDELAY_MONITOR))
+    {
+        gchar tooltip[256];
+
+        /* The marker shows the CPU with the longest waits */
+        systemload_bar_set_marker (SYSTEMLOAD_BAR (global->monitor[RUNDELAY_MONITOR]->status),
+                                   schedstat_status == 0 ? MIN (schedstat.worst_wait_per_slice / RUN_DELAY_FULL, 1) : -1);
+        if (schedstat_status == 0)
+            g_snprintf(tooltip, sizeof(tooltip),
+                       _("Run delay: %.0f \302\265s per timeslice\nWorst CPU %u: %.0f \302\265s per timeslice\nWaiting tasks per CPU: %.2f"),
+                       schedstat.wait_per_slice, schedstat.worst_cpu, schedstat.worst_wait_per_slice,
+                       schedstat.waiting);
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No scheduler statistics"));
+        set_tooltip(global->monitor[RUNDELAY_MONITOR]->ebox, tooltip);
+    }
+
+    if (monitor_due (config, due, IDLE_MONITOR))
+    {
+        gchar tooltip[CPUIDLE_MAX_PACKAGES * (64 + CPUIDLE_MAX_STATES * 40)];
+        gdouble segments[SYSTEMLOAD_BAR_MAX_SEGMENTS] = { 0 };
+        guint n_segments = 0;
+
+        if (cpuidle_status == 0)
+        {
+            /* The deepest state comes first, the shallowest states share the last segment */
+            guint n_cpus = 0;
+            for (guint i = 0; i < cpuidle.n_packages; i++)
+                n_cpus += cpuidle.packages[i].n_cpus;
+            n_segments = MIN (cpuidle.n_states, G_N_ELEMENTS (segments));
+            for (guint i = 0; i < cpuidle.n_packages && n_cpus != 0; i++)
+                for (guint state = 0; state < cpuidle.n_states; state++)
+                    segments[MIN (cpuidle.n_states - 1 - state, n_segments - 1)] +=
+                        cpuidle.packages[i].residency[state] * cpuidle.packages[i].n_cpus / n_cpus;
+
+            tooltip[0] = '\0';
+            gsize len = 0;
+            for (guint i = 0; i < cpuidle.n_packages && len < sizeof(tooltip); i++)
+            {
+                const t_cpuidle_package *package = &cpuidle.packages[i];
+                if (i != 0)
+                    len += g_strlcpy (tooltip + len, "\n", sizeof(tooltip) - len);
+                len += g_snprintf(tooltip + len, sizeof(tooltip) - len, _("Package %u, %u CPUs:"),
+                                  package->id, package->n_cpus);
+                for (guint state = 0; state < cpuidle.n_states && len < sizeof(tooltip); state++)
+                    len += g_snprintf(tooltip + len, sizeof(tooltip) - len, _("\n%s: %.0f%%, %.0f entries/s"),
+                                      cpuidle.names[state], package->residency[state] * 100, package->entries[state]);
+            }
+        }
+        else
+            g_snprintf(tooltip, sizeof(tooltip), _("No idle state information"));
+        systemload_bar_set_segments (SYSTEMLOAD_BAR (global->monitor[IDLE_MONITOR]->status), segments, n_segments);
+        set_tooltip(global->monitor[IDLE_MONITOR]->ebox, tooltip);
+    }
+
+    if (numa_due)
+    {
+        gchar tooltip[NUMA_MAX_NODES * 128];
+
+        if (n_numa_nodes == 0)
+            g_snprintf(tooltip, sizeof(tooltip), _("No NUMA nodes"));
+        else
+            tooltip[0] = '\0';
+        for (guint i = 0; i < n_numa_nodes; i++)
+        {
+            const t_numa_node *node = &numa_nodes[i];
+            gsize len = strlen (tooltip);
+            if (i != 0)
+                len += g_strlcpy (tooltip + len, "\n", sizeof(tooltip) - len);
+            g_snprintf(tooltip + len, sizeof(tooltip) - len,
+                       _("Node %u: %ldMB of %ldMB used, CPU %u%%\n%.0f misses/s, %.0f foreign/s"),
+                       node->id, node->mem_used >> 10, node->mem_total >> 10, node->cpu,
+                       node->miss_rate, node->foreign_rate);
+        }
+        set_tooltip(global->monitor[NUMA_MONITOR]->ebox, tooltip);
+    }
+
+    stats_record (STATS_WIDGETS, &t);
+}
+
+static gboolean update_uptime_cb(gpointer user_data);
+
+/*
+ * Updates the uptime label and schedules the next update for the moment the
+ * label or the tooltip (which shows minutes) can change next, independently
+ * of the update interval of the other monitors.
+ */
+static void
+update_uptime(t_global_monitor *global)
+{
+    gchar days_str[32], hours_str[32], mins_str[32];
+    gchar text[128], tooltip[128];
+
+    TRACE_SCOPE ("update_uptime");
+
+    gint64 t = stats_clock ();
+    guint msec;
+    gulong uptime = global->uptime.value_read =
+        read_uptime(systemload_config_get_uptime_exclude_suspend (global->config), &msec);
+    stats_record (STATS_READ_UPTIME, &t);
+
+    uptime_format_render (global->uptime.format, uptime, text, sizeof (text));
+    set_label_text(GTK_LABEL(global->uptime.label), text);
+
+    // Tooltip text
+    gint days = uptime / 86400;
+    gint hours = (uptime / 3600) % 24;
+    gint mins = (uptime / 60) % 60;
+
+    g_snprintf(days_str, sizeof(days_str), ngettext("%d day", "%d days", days), days);
+    g_snprintf(hours_str, sizeof(hours_str), ngettext("%d hour", "%d hours", hours), hours);
+    g_snprintf(mins_str, sizeof(mins_str), ngettext("%d minute", "%d minutes", mins), mins);
+
+    g_snprintf(tooltip, sizeof(tooltip), _("Uptime: %s, %s, %s"), days_str, hours_str, mins_str);
+    set_tooltip(global->uptime.ebox, tooltip);
+
+    gulong next_change = uptime_format_next_change (global->uptime.format, uptime);
+    gulong next_minute = 60 - uptime % 60;
+    if (next_change == 0 || next_change > next_minute)
+        next_change = next_minute;
+
+    if (global->uptime.timeout_id)
+        g_source_remove (global->uptime.timeout_id);
+    global->uptime.timeout_id = g_timeout_add (next_change * 1000 - msec, update_uptime_cb, global);
+}
+
+static gboolean
+update_uptime_cb(gpointer user_data)
+{
+    auto global = (t_global_monitor*) user_data;
+
+    global->uptime.timeout_id = 0;
+    update_uptime (global);
+    return G_SOURCE_REMOVE;
 }
 
 static void
@@ -300,9 +834,10 @@ monitor_update_orientation (XfcePanelPlugin  *plugin,
         gtk_orientable_set_orientation(GTK_ORIENTABLE(global->monitor[count]->box), panel_orientation);
         gtk_label_set_angle(GTK_LABEL(global->monitor[count]->label),
                             (orientation == GTK_ORIENTATION_HORIZONTAL) ? 0 : -90);
-        gtk_progress_bar_set_inverted (GTK_PROGRESS_BAR(global->monitor[count]->status), (panel_orientation == GTK_ORIENTATION_HORIZONTAL));
-        gtk_orientable_set_orientation (GTK_ORIENTABLE(global->monitor[count]->status),
+        systemload_bar_set_orientation (SYSTEMLOAD_BAR(global->monitor[count]->status),
                                         (panel_orientation == GTK_ORIENTATION_HORIZONTAL) ? GTK_ORIENTATION_VERTICAL : GTK_ORIENTATION_HORIZONTAL);
+        systemload_value_set_vertical (SYSTEMLOAD_VALUE(global->monitor[count]->value),
+                                       orientation == GTK_ORIENTATION_VERTICAL);
     }
     gtk_label_set_angle(GTK_LABEL(global->uptime.label),
                         (orientation == GTK_ORIENTATION_HORIZONTAL) ? 0 : -90);
@@ -316,6 +851,9 @@ create_monitor (t_global_monitor *global)
     global->box = gtk_box_new(xfce_panel_plugin_get_orientation(global->plugin), 0);
     gtk_widget_show(global->box);
 
+    /* One stylesheet shared by all bars, see setup_stylesheet() */
+    global->css_provider = gtk_css_provider_new ();
+
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
     {
         SystemloadMonitor monitor = VISUAL_ORDER[i];
@@ -323,19 +861,31 @@ create_monitor (t_global_monitor *global)
 
         m->label = gtk_label_new (systemload_config_get_label (config, monitor));
 
-        m->status = GTK_WIDGET(gtk_progress_bar_new());
-        GtkCssProvider *css_provider = gtk_css_provider_new ();
-        gtk_style_context_add_provider (
-            GTK_STYLE_CONTEXT (gtk_widget_get_style_context (GTK_WIDGET (m->status))),
-            GTK_STYLE_PROVIDER (css_provider),
-            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-        gtk_css_provider_load_from_data (css_provider, "\
-            progressbar.horizontal trough { min-height: 4px; }\
-            progressbar.horizontal progress { min-height: 4px; }\
-            progressbar.vertical trough { min-width: 4px; }\
-            progressbar.vertical progress { min-width: 4px; }",
-             -1, NULL);
-        g_object_set_data(G_OBJECT(m->status), "css_provider", css_provider);
+        m->status = systemload_bar_new();
+        GtkStyleContext *context = gtk_widget_get_style_context (GTK_WIDGET (m->status));
+        gtk_style_context_add_provider (context,
+                                        GTK_STYLE_PROVIDER (global->css_provider),
+                                        GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+        gtk_style_context_add_class (context, "systemload");
+        gtk_style_context_add_class (context, CSS_CLASS[monitor]);
+
+        if (monitor == CPU_MONITOR)
+        {
+            m->heatmap = systemload_heatmap_new ();
+            context = gtk_widget_get_style_context (m->heatmap);
+            gtk_style_context_add_provider (context,
+                                            GTK_STYLE_PROVIDER (global->css_provider),
+                                            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+            gtk_style_context_add_class (context, "systemload");
+            gtk_style_context_add_class (context, CSS_CLASS[monitor]);
+        }
+
+        /* Reserves the width of the widest value, see setup_monitor_visibility() for its visibility */
+        m->value = systemload_value_new();
+        if (monitor == NET_MONITOR)
+            systemload_value_set_reserved (SYSTEMLOAD_VALUE (m->value), RATE_RESERVED, G_N_ELEMENTS (RATE_RESERVED));
+        else
+            systemload_value_set_reserved (SYSTEMLOAD_VALUE (m->value), PERCENT_RESERVED, G_N_ELEMENTS (PERCENT_RESERVED));
 
         m->box = gtk_box_new(xfce_panel_plugin_get_orientation(global->plugin), 0);
 
@@ -350,7 +900,10 @@ create_monitor (t_global_monitor *global)
 
         gtk_widget_show(GTK_WIDGET(m->status));
 
+        gtk_box_pack_start(GTK_BOX(m->box), GTK_WIDGET(m->value), FALSE, FALSE, 0);
         gtk_box_pack_start(GTK_BOX(m->box), GTK_WIDGET(m->status), FALSE, FALSE, 0);
+        if (m->heatmap)
+            gtk_box_pack_start(GTK_BOX(m->box), m->heatmap, FALSE, FALSE, 0);
         gtk_box_pack_start(GTK_BOX(global->box), GTK_WIDGET(m->ebox), FALSE, FALSE, 0);
 
         gtk_widget_show_all(GTK_WIDGET(m->ebox));
@@ -375,7 +928,7 @@ create_monitor (t_global_monitor *global)
     gtk_event_box_set_visible_window(GTK_EVENT_BOX(global->ebox), FALSE);
     gtk_widget_show(GTK_WIDGET(global->ebox));
 
-    update_monitors (global);
+    update_monitors (global, ALL_MONITORS);
 }
 
 static t_global_monitor *
@@ -408,7 +961,9 @@ monitor_control_new(XfcePanelPlugin *plugin)
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
         global->monitor[i] = g_new0 (t_monitor, 1);
 
-    systemload_config_on_change (global->config, setup_monitor_cb, global);
+    global->scheduler = scheduler_new (update_monitors_cb, global);
+
+    systemload_config_on_change (global->config, configuration_changed_cb, global);
 
     return global;
 }
@@ -423,55 +978,135 @@ monitor_free(XfcePanelPlugin *plugin, t_global_monitor *global)
     }
 #endif
 
-    if (global->timeout_id)
-        g_source_remove(global->timeout_id);
+    scheduler_free (global->scheduler);
+    if (global->uptime.timeout_id)
+        g_source_remove(global->uptime.timeout_id);
+    uptime_format_free (global->uptime.format);
+    if (global->apply_changes_id)
+        g_source_remove(global->apply_changes_id);
+
+    trace_shutdown ();
+    procfs_shutdown ();
 
     g_free(global->command.command_text);
 
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
         g_free (global->monitor[i]);
 
+    if (global->css_provider)
+        g_object_unref (global->css_provider);
+
     g_free(global);
 }
 
-static gboolean
-update_monitors_cb(gpointer user_data)
+/*
+ * Adaptive sampling: doubles the interval of a monitor (up to the maximum)
+ * after a number of samples stayed within the band around the reference
+ * value, and returns to the regular interval as soon as a sample leaves it.
+ */
+static void
+adapt_interval(t_global_monitor *global, SystemloadMonitor monitor)
+{
+    const SystemloadConfig *config = global->config;
+    t_monitor *m = global->monitor[monitor];
+
+    if (!systemload_config_get_adaptive (config) || m->base_interval == 0)
+        return;
+
+    gulong value = MIN (m->value_read, 100);
+    gulong distance = (value > m->reference_value) ? value - m->reference_value : m->reference_value - value;
+    guint interval = m->interval;
+
+    if (distance > systemload_config_get_adaptive_band (config))
+    {
+        m->reference_value = value;
+        m->stable_samples = 0;
+        interval = m->base_interval;
+    }
+    else if (++m->stable_samples >= systemload_config_get_adaptive_hold (config))
+    {
+        guint max_interval = MAX (systemload_config_get_adaptive_max_interval (config), m->base_interval);
+        m->stable_samples = 0;
+        interval = MIN (interval * 2, max_interval);
+    }
+
+    if (interval != m->interval)
+    {
+        m->interval = interval;
+        scheduler_set_interval (global->scheduler, monitor, interval);
+    }
+}
+
+static void
+update_monitors_cb(guint32 due, gpointer user_data)
 {
     auto global = (t_global_monitor*) user_data;
 
-    update_monitors (global);
-    return TRUE;
+    gint64 t = stats_clock ();
+
+    update_monitors (global, due);
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+        if (due & (1u << i))
+            adapt_interval (global, (SystemloadMonitor) i);
+
+    stats_record (STATS_TICK, &t);
+    stats_maybe_log ();
 }
 
+/*
+ * Sets the intervals of all monitors. The power-saving interval is applied
+ * as a scale to all intervals, so that the monitors following the global
+ * update interval are updated every timeout_seconds on battery and the
+ * others are slowed down in the same proportion.
+ */
 static void
 setup_timer(t_global_monitor *global)
 {
     GtkSettings *settings;
-    if (global->timeout_id)
-        g_source_remove(global->timeout_id);
+    gdouble scale = 1.0;
+
 #ifdef HAVE_UPOWER_GLIB
     if (global->upower && global->use_timeout_seconds) {
         if (up_client_get_on_battery(global->upower)) {
             if (!up_client_get_lid_is_closed(global->upower)) {
-                global->timeout_id = g_timeout_add_seconds(
-                                        global->timeout_seconds,
-                                        update_monitors_cb, global);
+                scale = global->timeout_seconds * 1000.0 / global->timeout;
             } else {
-                /* Don't do any timeout if the lid is closed on battery */
-                global->timeout_id = 0;
+                /* Don't do any updates if the lid is closed on battery */
+                scale = 0;
             }
-            return;
         }
     }
 #endif
-    global->timeout_id = g_timeout_add(global->timeout, update_monitors_cb, global);
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        const auto monitor = (SystemloadMonitor) i;
+        t_monitor *m = global->monitor[monitor];
+        guint interval = 0;
+        if (systemload_config_get_enabled (global->config, monitor))
+        {
+            interval = systemload_config_get_interval (global->config, monitor);
+            if (interval == 0)
+                interval = global->timeout;
+            interval = MAX (interval, MIN_TIMEOUT);
+        }
+
+        /* Adaptive sampling starts again from the regular interval */
+        m->base_interval = m->interval = interval;
+        m->reference_value = MIN (m->value_read, 100);
+        m->stable_samples = 0;
+        scheduler_set_interval (global->scheduler, monitor, interval);
+    }
+    scheduler_set_scale (global->scheduler, scale);
+    scheduler_set_slack (global->scheduler, systemload_config_get_timer_slack (global->config));
+
     /* reduce the default tooltip timeout to be smaller than the update interval otherwise
      * we won't see tooltips on GTK 2.16 or newer */
     settings = gtk_settings_get_default();
     if (g_object_class_find_property(G_OBJECT_GET_CLASS(settings), "gtk-tooltip-timeout"))
         g_object_set(settings, "gtk-tooltip-timeout",
                      global->timeout - 10, NULL);
-
 }
 
 static void
@@ -489,12 +1124,47 @@ set_margin (const t_global_monitor *global, GtkWidget *w, gint margin)
     }
 }
 
+/*
+ * Builds the stylesheet shared by all bars. It contains the colors of all
+ * monitors and of all severities, so that it needs to be parsed again only
+ * if the user picks a different color.
+ */
 static void
-setup_monitors(t_global_monitor *global)
+setup_stylesheet(t_global_monitor *global)
 {
-    const SystemloadConfig *config = global->config;
+    GString *css = g_string_new (
+        "systemloadbar.systemload { background-color: alpha(currentColor, 0.2); }\n");
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        const GdkRGBA *color = systemload_config_get_color (global->config, (SystemloadMonitor) i);
+        if (G_LIKELY (color != NULL))
+        {
+            gchar *color_str = gdk_rgba_to_string(color);
+            g_string_append_printf (css, "systemloadbar.systemload.%s, systemloadheatmap.systemload.%s { color: %s; }\n",
+                                    CSS_CLASS[i], CSS_CLASS[i], color_str);
+            g_free(color_str);
+        }
+    }
+
+    /* Listed last to take precedence over the colors of the monitors */
+    for(gsize i = 0; i < G_N_ELEMENTS (SEVERITY_CLASS); i++)
+    {
+        if (SEVERITY_CLASS[i])
+            g_string_append_printf (css, "systemloadbar.systemload.%s { color: %s; }\n",
+                                    SEVERITY_CLASS[i], SEVERITY_COLOR[i]);
+    }
 
-    gtk_widget_hide(GTK_WIDGET(global->uptime.ebox));
+    gtk_css_provider_load_from_data (global->css_provider, css->str, css->len, NULL);
+    g_string_free (css, TRUE);
+}
+
+/* Updates labels, visibility and margins of all monitors without hiding them first */
+static void
+setup_monitor_visibility(t_global_monitor *global)
+{
+    const SystemloadConfig *config = global->config;
+    SystemloadDisplayMode display_mode = systemload_config_get_display_mode (config);
 
     /* determine the number of enabled monitors and the number of enabled labels */
     guint n_enabled = 0, n_enabled_labels = 0;
@@ -514,61 +1184,180 @@ setup_monitors(t_global_monitor *global)
     {
         const auto monitor = (SystemloadMonitor) i;
         const t_monitor *m = global->monitor[monitor];
-        const GdkRGBA *color = NULL;
-
-        gtk_widget_hide(m->ebox);
-        gtk_widget_hide(m->label);
-        gtk_label_set_text(GTK_LABEL(m->label), systemload_config_get_label (config, monitor));
-
-        color = systemload_config_get_color (config, monitor);
-        if (G_LIKELY (color != NULL))
-        {
-            gchar *color_str = gdk_rgba_to_string(color);
-            gchar *css;
-            css = g_strdup_printf("progressbar progress { background-color: %s; background-image: none; border-color: %s; }",
-                                  color_str, color_str);
-            gtk_css_provider_load_from_data (
-                (GtkCssProvider*) g_object_get_data(G_OBJECT(m->status), "css_provider"),
-                css, strlen(css), NULL);
-            g_free(color_str);
-            g_free(css);
-        }
-
-        if (systemload_config_get_enabled (config, monitor))
-        {
-            bool label_visible = systemload_config_get_use_label (config, monitor) &&
-                                 strlen (systemload_config_get_label (config, monitor)) != 0;
-
-            gtk_widget_show_all(GTK_WIDGET(m->ebox));
-            gtk_widget_set_visible (m->label, label_visible);
+        bool enabled = systemload_config_get_enabled (config, monitor);
+        bool label_visible = systemload_config_get_use_label (config, monitor) &&
+                             strlen (systemload_config_get_label (config, monitor)) != 0;
+
+        set_label_text(GTK_LABEL(m->label), systemload_config_get_label (config, monitor));
+        gtk_widget_set_visible (m->label, enabled && label_visible);
+        bool heatmap = m->heatmap && systemload_config_get_cpu_heatmap (config);
+        gtk_widget_set_visible (m->value, display_mode != DISPLAY_MODE_BAR);
+        gtk_widget_set_visible (m->status, display_mode != DISPLAY_MODE_VALUE && !heatmap);
+        if (m->heatmap)
+            gtk_widget_set_visible (m->heatmap, display_mode != DISPLAY_MODE_VALUE && heatmap);
+        if (label_visible && display_mode != DISPLAY_MODE_BAR)
+            gtk_widget_set_margin_start (m->value, 3);
+        else
+            gtk_widget_set_margin_start (m->value, 0);
+        gtk_widget_set_visible (m->ebox, enabled);
+        if (enabled)
             set_margin (global, m->ebox, (n_enabled_labels == 0) ? 0 : 6);
-        }
     }
 
+    gtk_widget_set_visible (global->uptime.ebox, systemload_config_get_uptime_enabled (config));
     if (systemload_config_get_uptime_enabled (config))
-    {
-        gtk_widget_show_all (global->uptime.ebox);
         set_margin (global, global->uptime.ebox, (n_enabled == 0) ? 0 : 6);
+}
+
+/* Compiles the uptime label and starts or stops the uptime updates */
+static void
+setup_uptime(t_global_monitor *global)
+{
+    uptime_format_free (global->uptime.format);
+    global->uptime.format = uptime_format_compile (systemload_config_get_uptime_label (global->config));
+
+    if (systemload_config_get_uptime_enabled (global->config))
+        update_uptime (global);
+    else if (global->uptime.timeout_id)
+    {
+        g_source_remove (global->uptime.timeout_id);
+        global->uptime.timeout_id = 0;
     }
+}
+
+static void
+setup_monitors(t_global_monitor *global)
+{
+    TRACE_SCOPE ("setup_monitors");
 
+    setup_stylesheet (global);
+    setup_monitor_visibility (global);
     setup_timer (global);
+    setup_uptime (global);
 }
 
+/* Recolors the bars after a change of the thresholds, from the values of the last read */
+static void
+redraw_severity(t_global_monitor *global)
+{
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        const auto monitor = (SystemloadMonitor) i;
+        if (systemload_config_get_enabled (global->config, monitor) &&
+            monitor != FREQ_MONITOR && monitor != IDLE_MONITOR)
+            set_severity (global, global->monitor[monitor], MIN (global->monitor[monitor]->value_read, 100));
+    }
+}
+
+/*
+ * Changes of the colors and labels are applied by the stylesheet and the
+ * label widgets alone. Only the monitors whose data depends on the change
+ * are read again, so that editing the settings doesn't cost extra reads of
+ * every monitor.
+ */
 static gboolean
-setup_monitor_cb(gpointer user_data)
+apply_changes_cb(gpointer user_data)
 {
     auto global = (t_global_monitor*) user_data;
-    setup_monitors (global);
-    update_monitors (global);
-    return TRUE;
+    const SystemloadConfig *config = global->config;
+    bool visibility_changed = false, color_changed = false, intervals_changed = false;
+    guint reread = 0;
+
+    TRACE_SCOPE ("apply_changes");
+
+    global->apply_changes_id = 0;
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        guint changes = global->pending_changes[i];
+        global->pending_changes[i] = 0;
+
+        if (changes & SYSTEMLOAD_CHANGE_COLOR)
+            color_changed = true;
+        if (changes & (SYSTEMLOAD_CHANGE_VISIBILITY | SYSTEMLOAD_CHANGE_LABEL))
+            visibility_changed = true;
+        if (changes & (SYSTEMLOAD_CHANGE_VISIBILITY | SYSTEMLOAD_CHANGE_INTERVAL))
+            intervals_changed = true;
+        if (changes & (SYSTEMLOAD_CHANGE_VISIBILITY | SYSTEMLOAD_CHANGE_MARKER | SYSTEMLOAD_CHANGE_AGGREGATION |
+                       SYSTEMLOAD_CHANGE_SEGMENTS | SYSTEMLOAD_CHANGE_SWAP_MODE))
+            reread |= 1u << i;
+    }
+
+    guint changes = global->pending_global_changes;
+    global->pending_global_changes = 0;
+
+    if (changes & SYSTEMLOAD_CHANGE_ADAPTIVE)
+        intervals_changed = true;
+
+    if (changes & (SYSTEMLOAD_CHANGE_UPTIME | SYSTEMLOAD_CHANGE_DISPLAY_MODE))
+        visibility_changed = true;
+    if (color_changed)
+        setup_stylesheet (global);
+    if (visibility_changed)
+        setup_monitor_visibility (global);
+
+    if (changes & (SYSTEMLOAD_CHANGE_UPTIME | SYSTEMLOAD_CHANGE_UPTIME_LABEL))
+        setup_uptime (global);
+
+    if (changes & SYSTEMLOAD_CHANGE_COMMAND)
+    {
+        g_free (global->command.command_text);
+        global->command.command_text = g_strdup (systemload_config_get_system_monitor_command (config));
+        global->command.enabled = (strlen (global->command.command_text) != 0);
+    }
+
+    if (changes & SYSTEMLOAD_CHANGE_TIMEOUT)
+    {
+        global->timeout = MAX (systemload_config_get_timeout (config), MIN_TIMEOUT);
+        global->timeout_seconds = systemload_config_get_timeout_seconds (config);
+        global->use_timeout_seconds = (global->timeout_seconds > 0);
+        intervals_changed = true;
+    }
+
+    if (intervals_changed)
+        setup_timer (global);
+
+    /* The texts of the values are only formatted while reading */
+    if (changes & SYSTEMLOAD_CHANGE_DISPLAY_MODE)
+        reread = ALL_MONITORS;
+    if (changes & SYSTEMLOAD_CHANGE_THRESHOLDS)
+        redraw_severity (global);
+
+    if (reread != 0)
+        update_monitors (global, reread);
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * Collects the changes and applies them at once from an idle callback,
+ * because xfconf and the settings dialog tend to change several properties in a row.
+ */
+static void
+configuration_changed_cb(SystemloadConfig *config, gint monitor, guint changes, gpointer user_data)
+{
+    auto global = (t_global_monitor*) user_data;
+
+    trace_instant ("configuration_changed");
+
+    if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (global->pending_changes))
+        global->pending_changes[monitor] |= changes;
+    else
+        global->pending_global_changes |= changes;
+
+    if (global->apply_changes_id == 0)
+        global->apply_changes_id = g_idle_add (apply_changes_cb, global);
 }
 
 static gboolean
 monitor_set_size(XfcePanelPlugin *plugin, int size, t_global_monitor *global)
 {
-    gtk_container_set_border_width (GTK_CONTAINER (global->ebox), (size > 26 ? 2 : 1));
+    const gint border = (size > 26 ? 2 : 1);
+    gtk_container_set_border_width (GTK_CONTAINER (global->ebox), border);
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
     {
+        if (global->monitor[i]->heatmap)
+            systemload_heatmap_set_panel_size (SYSTEMLOAD_HEATMAP (global->monitor[i]->heatmap),
+                                               xfce_panel_plugin_get_orientation (plugin), size - 2 * border);
         if (xfce_panel_plugin_get_orientation (plugin) == GTK_ORIENTATION_HORIZONTAL)
         {
             gtk_widget_set_size_request(GTK_WIDGET(global->monitor[i]->status), 8, -1);
@@ -579,7 +1368,7 @@ monitor_set_size(XfcePanelPlugin *plugin, int size, t_global_monitor *global)
         }
     }
 
-    setup_monitors (global);
+    setup_monitor_visibility (global);
 
     return TRUE;
 }
@@ -610,14 +1399,6 @@ upower_changed_cb(UpClient *client, GParamSpec *pspec, t_global_monitor *global)
 }
 #endif /* HAVE_UPOWER_GLIB */
 
-static void
-command_entry_changed_cb(GtkEntry *entry, t_global_monitor *global)
-{
-    g_free (global->command.command_text);
-    global->command.command_text = g_strdup (gtk_entry_get_text (GTK_ENTRY (entry)));
-    global->command.enabled = (strlen (global->command.command_text) != 0);
-}
-
 static void
 switch_cb(GtkSwitch *check_button, gboolean state, t_global_monitor *global)
 {
@@ -641,24 +1422,6 @@ monitor_dialog_response (GtkWidget *dlg, int response,
     }
 }
 
-static void
-change_timeout_cb(GtkSpinButton *spin, t_global_monitor *global)
-{
-    global->timeout = gtk_spin_button_get_value(spin);
-
-    setup_timer(global);
-}
-
-#ifdef HAVE_UPOWER_GLIB
-static void
-change_timeout_seconds_cb(GtkSpinButton *spin, t_global_monitor *global)
-{
-    global->timeout_seconds = gtk_spin_button_get_value (spin);
-    global->use_timeout_seconds = (global->timeout_seconds != 0);
-    setup_timer (global);
-}
-#endif
-
 /* Creates a label, its mnemonic will point to target.
  * Returns the widget. */
 static GtkWidget *new_label (GtkGrid *grid, guint row, const gchar *labeltext, GtkWidget *target)
@@ -737,7 +1500,7 @@ new_monitor_setting (t_global_monitor *global,
 
     if (color)
     {
-        /* Colorbutton to set the progressbar color */
+        /* Colorbutton to set the bar color */
         GtkWidget *button = gtk_color_button_new ();
         gtk_color_chooser_set_use_alpha (GTK_COLOR_CHOOSER (button), TRUE);
 
@@ -750,8 +1513,110 @@ new_monitor_setting (t_global_monitor *global,
                                 GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
         g_free (setting_name);
         gtk_grid_attach(GTK_GRID(subgrid), button, 2, 0, 1, 1);
+
+        /* Update interval of this monitor */
+        label = gtk_label_new_with_mnemonic (_("_Interval:"));
+        gtk_widget_set_halign (label, GTK_ALIGN_START);
+        gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+        gtk_widget_set_margin_start (label, 12);
+        gtk_grid_attach (GTK_GRID(subgrid), label, 0, 1, 1, 1);
+
+        button = gtk_spin_button_new_with_range (0, MAX_INTERVAL, 100);
+        gtk_label_set_mnemonic_widget (GTK_LABEL (label), button);
+        gtk_widget_set_halign (button, GTK_ALIGN_START);
+        gtk_widget_set_tooltip_text (button, _("Uses the update interval if set to zero"));
+        setting_name = g_strconcat (setting, "-interval", NULL);
+        g_object_bind_property (G_OBJECT (global->config), setting_name,
+                                G_OBJECT (button), "value",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_free (setting_name);
+        GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+        gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+        gtk_box_pack_start (GTK_BOX (box), gtk_label_new ("ms"), FALSE, FALSE, 0);
+        gtk_grid_attach (GTK_GRID(subgrid), box, 1, 1, 2, 1);
+    }
+
+#ifdef __linux__
+    if (g_strcmp0 (setting, "cpu") == 0)
+    {
+        GtkWidget *check = gtk_check_button_new_with_mnemonic (_("Mark the _busiest core"));
+        gtk_widget_set_margin_start (check, 12);
+        gtk_widget_set_tooltip_text (check, _("Shows the utilization of the busiest core as a marker on the bar and in the tooltip"));
+        g_object_bind_property (G_OBJECT (global->config), "cpu-peak",
+                                G_OBJECT (check), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach(GTK_GRID(subgrid), check, 0, 2, 3, 1);
+
+        check = gtk_check_button_new_with_mnemonic (_("Show each core in a _heatmap"));
+        gtk_widget_set_margin_start (check, 12);
+        gtk_widget_set_tooltip_text (check, _("Replaces the bar by a compact grid with one cell per core, for hosts with many cores"));
+        g_object_bind_property (G_OBJECT (global->config), "cpu-heatmap",
+                                G_OBJECT (check), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach(GTK_GRID(subgrid), check, 0, 3, 3, 1);
+
+        label = gtk_label_new_with_mnemonic (_("_Aggregation:"));
+        gtk_widget_set_halign (label, GTK_ALIGN_START);
+        gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+        gtk_widget_set_margin_start (label, 12);
+        gtk_grid_attach (GTK_GRID(subgrid), label, 0, 4, 1, 1);
+
+        GtkWidget *combo = gtk_combo_box_text_new ();
+        gtk_label_set_mnemonic_widget (GTK_LABEL (label), combo);
+        gtk_widget_set_halign (combo, GTK_ALIGN_START);
+        gtk_widget_set_tooltip_text (combo, _("Physical cores count with their busiest hardware thread, the bar shows the busiest group"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("All CPUs"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Physical cores"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Core types"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Packages"));
+        g_object_bind_property (G_OBJECT (global->config), "cpu-aggregation",
+                                G_OBJECT (combo), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach (GTK_GRID(subgrid), combo, 1, 4, 2, 1);
+    }
+
+    if (g_strcmp0 (setting, "memory") == 0)
+    {
+        GtkWidget *check = gtk_check_button_new_with_mnemonic (_("Show the _composition of the memory"));
+        gtk_widget_set_margin_start (check, 12);
+        gtk_widget_set_tooltip_text (check, _("Stacks anonymous memory, shared memory, kernel memory, slab, dirty pages and page cache in the bar"));
+        g_object_bind_property (G_OBJECT (global->config), "memory-composition",
+                                G_OBJECT (check), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach(GTK_GRID(subgrid), check, 0, 2, 3, 1);
+    }
+
+    if (g_strcmp0 (setting, "swap") == 0)
+    {
+        label = gtk_label_new_with_mnemonic (_("_Bar shows:"));
+        gtk_widget_set_halign (label, GTK_ALIGN_START);
+        gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+        gtk_widget_set_margin_start (label, 12);
+        gtk_grid_attach (GTK_GRID(subgrid), label, 0, 2, 1, 1);
+
+        GtkWidget *combo = gtk_combo_box_text_new ();
+        gtk_label_set_mnemonic_widget (GTK_LABEL (label), combo);
+        gtk_widget_set_halign (combo, GTK_ALIGN_START);
+        gtk_widget_set_tooltip_text (combo, _("Heavy swapping in and out means thrashing, a full swap without paging is harmless"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Used swap"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Swap I/O rate"));
+        g_object_bind_property (G_OBJECT (global->config), "swap-mode",
+                                G_OBJECT (combo), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach (GTK_GRID(subgrid), combo, 1, 2, 2, 1);
     }
 
+    if (g_strcmp0 (setting, "uptime") == 0)
+    {
+        GtkWidget *check = gtk_check_button_new_with_mnemonic (_("E_xclude time spent in suspend"));
+        gtk_widget_set_margin_start (check, 12);
+        g_object_bind_property (G_OBJECT (global->config), "uptime-exclude-suspend",
+                                G_OBJECT (check), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        gtk_grid_attach(GTK_GRID(subgrid), check, 0, 1, 2, 1);
+    }
+#endif
+
     switch_cb (GTK_SWITCH (sw), enabled, global);
 }
 
@@ -766,13 +1631,26 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
             N_ ("Memory monitor"),
             N_ ("Network monitor"),
             N_ ("Swap monitor"),
-            N_ ("Uptime monitor")
+            N_ ("NUMA monitor"),
+            N_ ("Frequency monitor"),
+            N_ ("Load average monitor"),
+            N_ ("Scheduler activity monitor"),
+            N_ ("Interrupt distribution monitor"),
+            N_ ("Run delay monitor"),
+            N_ ("Idle state monitor"),
     };
     static const gchar *SETTING_TEXT[] = {
             "cpu",
             "memory",
             "network",
-            "swap"
+            "swap",
+            "numa",
+            "frequency",
+            "loadavg",
+            "activity",
+            "interrupts",
+            "rundelay",
+            "cpuidle",
     };
 
     GtkWidget *dlg;
@@ -818,7 +1696,6 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
     g_object_bind_property (G_OBJECT (config), "timeout",
                             G_OBJECT (button), "value",
                             GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
-    g_signal_connect (G_OBJECT (button), "value-changed", G_CALLBACK(change_timeout_cb), global);
     box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
     label = gtk_label_new ("ms");
     gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
@@ -835,7 +1712,6 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
     g_object_bind_property (G_OBJECT (config), "timeout-seconds",
                             G_OBJECT (button), "value",
                             GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
-    g_signal_connect (G_OBJECT (button), "value-changed", G_CALLBACK(change_timeout_seconds_cb), global);
     box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
     label = gtk_label_new ("s");
     gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
@@ -852,24 +1728,101 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
     g_object_bind_property (G_OBJECT (config), "system-monitor-command",
                             G_OBJECT (entry), "text",
                             GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
-    g_signal_connect (G_OBJECT(entry), "changed",
-                      G_CALLBACK(command_entry_changed_cb), global);
     gtk_grid_attach (GTK_GRID (grid), entry, 1, 3, 1, 1);
     new_label (GTK_GRID (grid), 3, _("System monitor:"), entry);
 
+    /* Thresholds for recoloring the bars */
+    button = gtk_spin_button_new_with_range (0, 100, 1);
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("Bars above this value are shown in yellow (disabled if set to zero)"));
+    g_object_bind_property (G_OBJECT (config), "warning-threshold",
+                            G_OBJECT (button), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    label = gtk_label_new ("%");
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 4, 1, 1);
+    new_label (GTK_GRID (grid), 4, _("Warning threshold:"), button);
+
+    button = gtk_spin_button_new_with_range (0, 100, 1);
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("Bars above this value are shown in red (disabled if set to zero)"));
+    g_object_bind_property (G_OBJECT (config), "critical-threshold",
+                            G_OBJECT (button), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    label = gtk_label_new ("%");
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 5, 1, 1);
+    new_label (GTK_GRID (grid), 5, _("Critical threshold:"), button);
+
+    /* Bars and/or values */
+    button = gtk_combo_box_text_new ();
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (button), _("Bar"));
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (button), _("Bar and value"));
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (button), _("Value"));
+    g_object_bind_property (G_OBJECT (config), "display-mode",
+                            G_OBJECT (button), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (GTK_GRID (grid), button, 1, 6, 1, 1);
+    new_label (GTK_GRID (grid), 6, _("Display:"), button);
+
+    /* Adaptive sampling */
+    GtkWidget *adaptive = gtk_switch_new ();
+    gtk_widget_set_halign (adaptive, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text (adaptive, _("Update less often while the values don't change"));
+    g_object_bind_property (G_OBJECT (config), "adaptive",
+                            G_OBJECT (adaptive), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (GTK_GRID (grid), adaptive, 1, 7, 1, 1);
+    new_label (GTK_GRID (grid), 7, _("Adaptive interval:"), adaptive);
+
+    static const struct {
+        const gchar *property, *text, *unit, *tooltip;
+        gdouble min, max, step;
+    } ADAPTIVE_SETTINGS[] = {
+        { "adaptive-max-interval", N_("Maximum interval:"), "ms",
+          N_("Longest interval used while the values don't change"), MIN_TIMEOUT, MAX_INTERVAL, 100 },
+        { "adaptive-band", N_("Change threshold:"), "%",
+          N_("Changes up to this value are considered noise and slow down the updates"), 0, 50, 1 },
+        { "adaptive-hold", N_("Samples before slowing down:"), "",
+          N_("Number of unchanged samples before the interval is doubled. Lower values slow down faster."), 1, 100, 1 },
+    };
+    for (gsize i = 0; i < G_N_ELEMENTS (ADAPTIVE_SETTINGS); i++)
+    {
+        button = gtk_spin_button_new_with_range (ADAPTIVE_SETTINGS[i].min, ADAPTIVE_SETTINGS[i].max, ADAPTIVE_SETTINGS[i].step);
+        gtk_widget_set_halign (button, GTK_ALIGN_START);
+        gtk_widget_set_tooltip_text (button, _(ADAPTIVE_SETTINGS[i].tooltip));
+        g_object_bind_property (G_OBJECT (config), ADAPTIVE_SETTINGS[i].property,
+                                G_OBJECT (button), "value",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_object_bind_property (G_OBJECT (config), "adaptive",
+                                G_OBJECT (button), "sensitive",
+                                G_BINDING_SYNC_CREATE);
+        box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+        gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+        gtk_box_pack_start (GTK_BOX (box), gtk_label_new (ADAPTIVE_SETTINGS[i].unit), FALSE, FALSE, 0);
+        gtk_grid_attach (GTK_GRID (grid), box, 1, 8 + i, 1, 1);
+        label = new_label (GTK_GRID (grid), 8 + i, _(ADAPTIVE_SETTINGS[i].text), button);
+        gtk_widget_set_margin_start (label, 24);
+    }
+
     /* Add options for the monitors */
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
     {
         const SystemloadMonitor monitor = VISUAL_ORDER[i];
-        new_monitor_setting (global, GTK_GRID(grid), 4 + 2 * i,
+        new_monitor_setting (global, GTK_GRID(grid), 11 + 2 * i,
                              _(FRAME_TEXT[monitor]),
                              true,
                              SETTING_TEXT[monitor]);
     }
 
     /* Uptime monitor options */
-    new_monitor_setting (global, GTK_GRID(grid), 4 + 2*G_N_ELEMENTS (global->monitor),
-                         _(FRAME_TEXT[4]), FALSE, "uptime");
+    new_monitor_setting (global, GTK_GRID(grid), 11 + 2*G_N_ELEMENTS (global->monitor),
+                         _("Uptime monitor"), FALSE, "uptime");
 
     gtk_widget_show_all (dlg);
 }
@@ -904,6 +1857,8 @@ systemload_construct (XfcePanelPlugin *plugin)
 {
     xfce_textdomain(GETTEXT_PACKAGE, PACKAGE_LOCALE_DIR, "UTF-8");
 
+    trace_init ();
+
 #ifdef HAVE_LIBGTOP
     /* Consider add glibtop_close() somewhere */
     glibtop_init();
@@ -918,7 +1873,7 @@ systemload_construct (XfcePanelPlugin *plugin)
 
     gtk_container_add (GTK_CONTAINER (plugin), global->ebox);
 
-    update_monitors (global);
+    update_monitors (global, ALL_MONITORS);
 
 #ifdef HAVE_UPOWER_GLIB
     if (global->upower) {
@@ -0,0 +1,321 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <glib/gi18n.h>
+
+#include "cpu.h"
+#include "procfs.h"
+#include "topology.h"
+
+#ifdef __linux__
+
+#define SYSFS_CPU "/sys/devices/system/cpu"
+
+/* Capacity reported by kernels without asymmetric CPU capacities */
+#define DEFAULT_CAPACITY 1024
+
+struct t_cpu_topology {
+    gint    core;       /* Index of the physical core, -1 if the CPU is offline */
+};
+
+struct t_core_topology {
+    guint   id;         /* core_id, unique within the package */
+    guint   type;       /* Index into capacities */
+    guint   package;    /* Index into packages */
+};
+
+static t_cpu_topology  *cpus;
+static guint            n_cpus_known;
+static t_core_topology *cores;
+static guint            n_cores;
+static guint            capacities[TOPOLOGY_MAX_GROUPS];   /* Descending */
+static guint            n_capacities;
+static guint64          packages[TOPOLOGY_MAX_GROUPS];     /* Ascending */
+static guint            n_packages;
+static gchar           *online;                            /* Contents of SYSFS_CPU/online */
+static guint8          *core_loads;                        /* Of the last topology_aggregate() */
+static guint            n_core_loads;
+static bool             valid;
+
+/* Returns the index of value in the sorted array, inserting it if needed */
+static gint
+insert_sorted (guint64 *values, guint *n, guint64 value, bool descending)
+{
+    guint i = 0;
+    while (i < *n && (descending ? values[i] > value : values[i] < value))
+        i++;
+    if (i < *n && values[i] == value)
+        return i;
+    if (*n == TOPOLOGY_MAX_GROUPS)
+        return -1;
+
+    memmove (values + i + 1, values + i, (*n - i) * sizeof (*values));
+    values[i] = value;
+    (*n)++;
+    return i;
+}
+
+static void
+load_topology (guint n_cpus)
+{
+    /* Physical cores are identified by their package and core_id */
+    guint64 *core_keys = g_new (guint64, n_cpus);
+    guint64 *core_packages = g_new (guint64, n_cpus);
+    guint64 *core_capacities = g_new (guint64, n_cpus);
+    guint64 sorted_capacities[TOPOLOGY_MAX_GROUPS];
+
+    cpus = g_renew (t_cpu_topology, cpus, n_cpus);
+    n_cpus_known = n_cpus;
+    n_cores = n_capacities = n_packages = 0;
+    valid = true;
+
+    for (guint cpu = 0; cpu < n_cpus && valid; cpu++)
+    {
+        gchar path[128];
+        guint64 core_id, package_id, capacity;
+
+        cpus[cpu].core = -1;
+        g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/topology/core_id", cpu);
+        if (!procfs_read_number (path, &core_id))
+            continue;
+        g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/topology/physical_package_id", cpu);
+        if (!procfs_read_number (path, &package_id))
+            continue;
+        g_snprintf (path, sizeof (path), SYSFS_CPU "/cpu%u/cpu_capacity", cpu);
+        if (!procfs_read_number (path, &capacity))
+            capacity = DEFAULT_CAPACITY;
+
+        guint64 key = (package_id << 32) | (core_id & 0xffffffff);
+        guint core = 0;
+        while (core < n_cores && core_keys[core] != key)
+            core++;
+        if (core == n_cores)
+        {
+            core_keys[core] = key;
+            core_packages[core] = package_id;
+            core_capacities[core] = capacity;
+            n_cores++;
+        }
+        /* The capacity of a physical core is the one of its fastest thread */
+        else if (capacity > core_capacities[core])
+        {
+            core_capacities[core] = capacity;
+        }
+
+        cpus[cpu].core = core;
+    }
+
+    cores = g_renew (t_core_topology, cores, n_cores);
+    for (guint core = 0; core < n_cores && valid; core++)
+        valid = insert_sorted (sorted_capacities, &n_capacities, core_capacities[core], true) >= 0 &&
+                insert_sorted (packages, &n_packages, core_packages[core], false) >= 0;
+    for (guint core = 0; core < n_cores && valid; core++)
+    {
+        cores[core].id = core_keys[core] & 0xffffffff;
+        cores[core].type = insert_sorted (sorted_capacities, &n_capacities, core_capacities[core], true);
+        cores[core].package = insert_sorted (packages, &n_packages, core_packages[core], false);
+    }
+    for (guint i = 0; i < n_capacities; i++)
+        capacities[i] = sorted_capacities[i];
+
+    if (n_cores == 0)
+        valid = false;
+    if (!valid)
+        g_debug ("CPU topology is not available or has more than %d groups", TOPOLOGY_MAX_GROUPS);
+
+    g_free (core_keys);
+    g_free (core_packages);
+    g_free (core_capacities);
+}
+
+/* Reloads the topology after CPU hotplug */
+static void
+check_topology (guint n_cpus)
+{
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (SYSFS_CPU "/online"), &length);
+
+    bool changed = n_cpus != n_cpus_known;
+    if (contents && (online == NULL || strlen (online) != length || memcmp (online, contents, length) != 0))
+    {
+        g_free (online);
+        online = g_strndup (contents, length);
+        changed = true;
+    }
+
+    if (changed)
+        load_topology (n_cpus);
+}
+
+static void
+set_group_name (t_cpu_group *group, SystemloadCpuAggregation aggregation, guint index)
+{
+    switch (aggregation)
+    {
+        case CPU_AGGREGATION_CORE_TYPE:
+            if (n_capacities == 1)
+                g_strlcpy (group->name, _("All cores"), sizeof (group->name));
+            else if (n_capacities == 2)
+                g_strlcpy (group->name, index == 0 ? _("P-cores") : _("E-cores"), sizeof (group->name));
+            else
+                g_snprintf (group->name, sizeof (group->name), _("Capacity %u"), capacities[index]);
+            break;
+        case CPU_AGGREGATION_PACKAGE:
+            g_snprintf (group->name, sizeof (group->name), _("Package %" G_GUINT64_FORMAT), packages[index]);
+            break;
+        default:
+            if (n_packages > 1)
+                g_snprintf (group->name, sizeof (group->name), _("Package %" G_GUINT64_FORMAT " core %u"),
+                            packages[cores[index].package], cores[index].id);
+            else
+                g_snprintf (group->name, sizeof (group->name), _("Core %u"), cores[index].id);
+            break;
+    }
+}
+
+/*
+ * One group per physical core. Machines with more cores than groups get
+ * their busiest cores, so that the busiest group is still the busiest core.
+ * The groups are in the order of the cores.
+ */
+static guint
+aggregate_cores (t_cpu_group *groups, guint max_groups)
+{
+    guint selected[TOPOLOGY_MAX_GROUPS];
+    guint n_selected = 0;
+
+    max_groups = MIN (max_groups, TOPOLOGY_MAX_GROUPS);
+    for (guint core = 0; core < n_cores; core++)
+    {
+        if (core_loads[core] == CPU_CORE_NO_DATA)
+            continue;
+
+        /* selected is kept sorted by descending load */
+        guint i = n_selected;
+        while (i > 0 && core_loads[selected[i - 1]] < core_loads[core])
+            i--;
+        if (i == max_groups)
+            continue;
+        if (n_selected < max_groups)
+            n_selected++;
+        memmove (selected + i + 1, selected + i, (n_selected - 1 - i) * sizeof (*selected));
+        selected[i] = core;
+    }
+
+    /* Back to the order of the cores */
+    for (guint i = 1; i < n_selected; i++)
+        for (guint j = i; j > 0 && selected[j - 1] > selected[j]; j--)
+        {
+            guint tmp = selected[j];
+            selected[j] = selected[j - 1];
+            selected[j - 1] = tmp;
+        }
+
+    for (guint i = 0; i < n_selected; i++)
+    {
+        set_group_name (&groups[i], CPU_AGGREGATION_PHYSICAL_CORE, selected[i]);
+        groups[i].load = core_loads[selected[i]];
+    }
+    return n_selected;
+}
+
+guint
+topology_aggregate (SystemloadCpuAggregation aggregation,
+                    const guint8 *loads, guint n_cpus,
+                    t_cpu_group *groups, guint max_groups)
+{
+    if (aggregation == CPU_AGGREGATION_ALL || n_cpus == 0)
+        return 0;
+
+    check_topology (n_cpus);
+    if (!valid)
+        return 0;
+
+    if (n_core_loads < n_cores)
+    {
+        core_loads = g_renew (guint8, core_loads, n_cores);
+        n_core_loads = n_cores;
+    }
+    memset (core_loads, CPU_CORE_NO_DATA, n_cores);
+
+    /* A physical core is as busy as its busiest hardware thread */
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        gint core = cpus[cpu].core;
+        if (core >= 0 && loads[cpu] != CPU_CORE_NO_DATA &&
+            (core_loads[core] == CPU_CORE_NO_DATA || loads[cpu] > core_loads[core]))
+            core_loads[core] = loads[cpu];
+    }
+
+    if (aggregation == CPU_AGGREGATION_PHYSICAL_CORE)
+        return aggregate_cores (groups, max_groups);
+
+    guint n_groups;
+    switch (aggregation)
+    {
+        case CPU_AGGREGATION_CORE_TYPE: n_groups = n_capacities; break;
+        default:                        n_groups = n_packages; break;
+    }
+    n_groups = MIN (n_groups, max_groups);
+
+    guint sum[TOPOLOGY_MAX_GROUPS] = {};
+    guint count[TOPOLOGY_MAX_GROUPS] = {};
+    for (guint core = 0; core < n_cores; core++)
+    {
+        if (core_loads[core] == CPU_CORE_NO_DATA)
+            continue;
+
+        guint group = (aggregation == CPU_AGGREGATION_CORE_TYPE) ? cores[core].type : cores[core].package;
+        if (group < n_groups)
+        {
+            sum[group] += core_loads[core];
+            count[group]++;
+        }
+    }
+
+    for (guint i = 0; i < n_groups; i++)
+    {
+        set_group_name (&groups[i], aggregation, i);
+        groups[i].load = count[i] != 0 ? (sum[i] + count[i] / 2) / count[i] : 0;
+    }
+
+    return n_groups;
+}
+
+#else
+
+guint
+topology_aggregate (SystemloadCpuAggregation aggregation,
+                    const guint8 *loads, guint n_cpus,
+                    t_cpu_group *groups, guint max_groups)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_TOPOLOGY_H_
+#define _XFCE_SYSTEMLOAD_TOPOLOGY_H_
+
+#include <gtk/gtk.h>
+
+#include "settings.h"
+
+/*
+ * CPU topology from /sys/devices/system/cpu/cpu*: the physical core and
+ * package of each CPU and its capacity, which tells performance cores from
+ * efficiency cores on hybrid machines. The topology is read once and read
+ * again when the set of online CPUs changes.
+ *
+ * A physical core counts with the load of its busiest hardware thread, so
+ * that a core is saturated once one SMT sibling is. A group counts with the
+ * average of its physical cores.
+ */
+
+#define TOPOLOGY_MAX_GROUPS 16
+
+struct t_cpu_group {
+    gchar   name[32];   /* Like "Package 0", "P-cores" or "Core 3" */
+    guint   load;       /* Percent */
+};
+
+/*
+ * Aggregates the per-CPU loads from read_cpuload_cores(), returns the number
+ * of groups or 0 if the topology is unknown. CPU_AGGREGATION_PHYSICAL_CORE
+ * returns one group per physical core, the busiest ones if there are more
+ * cores than max_groups.
+ */
+guint   topology_aggregate   (SystemloadCpuAggregation aggregation,
+                              const guint8 *loads, guint n_cpus,
+                              t_cpu_group *groups, guint max_groups);
+
+#endif /* _XFCE_SYSTEMLOAD_TOPOLOGY_H_ */
@@ -0,0 +1,214 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+/* Must be a power of two */
+#define RING_SIZE 16384
+
+/* Maximum delay between an event being recorded and being written out */
+#define FLUSH_INTERVAL G_USEC_PER_SEC
+
+struct t_trace_event {
+    const gchar  *name;
+    gint64        ts;
+    gint64        dur;   /* -1 for instant events */
+};
+
+/*
+ * Single-producer, single-consumer ring buffer. The main thread only
+ * advances head, the writer thread only advances tail.
+ */
+static t_trace_event *ring;
+static guint          head;
+static guint          tail;
+static guint          dropped;
+
+static FILE          *out;
+static bool           first_event;
+static GThread       *writer;
+static GMutex         writer_mutex;
+static GCond          writer_cond;
+static bool           writer_quit;
+static bool           writer_kicked;
+
+bool trace_active = false;
+
+static void
+write_events ()
+{
+    guint t = tail;
+    guint h = __atomic_load_n (&head, __ATOMIC_ACQUIRE);
+    const long pid = (long) getpid ();
+
+    for (; t != h; t++)
+    {
+        const t_trace_event *e = &ring[t & (RING_SIZE - 1)];
+        /* JSON has no trailing comma, the separator goes before each event but the first */
+        if (!first_event)
+            fputs (",\n", out);
+        first_event = false;
+        if (e->dur >= 0)
+            fprintf (out, "{\"name\":\"%s\",\"cat\":\"systemload\",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT
+                          ",\"dur\":%" G_GINT64_FORMAT ",\"pid\":%ld,\"tid\":%ld}",
+                     e->name, e->ts, e->dur, pid, pid);
+        else
+            fprintf (out, "{\"name\":\"%s\",\"cat\":\"systemload\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%" G_GINT64_FORMAT
+                          ",\"pid\":%ld,\"tid\":%ld}",
+                     e->name, e->ts, pid, pid);
+    }
+
+    __atomic_store_n (&tail, t, __ATOMIC_RELEASE);
+    fflush (out);
+}
+
+static gpointer
+writer_thread (gpointer data)
+{
+    g_mutex_lock (&writer_mutex);
+    while (!writer_quit)
+    {
+        if (!writer_kicked)
+            g_cond_wait_until (&writer_cond, &writer_mutex, g_get_monotonic_time () + FLUSH_INTERVAL);
+        writer_kicked = false;
+
+        g_mutex_unlock (&writer_mutex);
+        write_events ();
+        g_mutex_lock (&writer_mutex);
+    }
+    g_mutex_unlock (&writer_mutex);
+
+    write_events ();
+    return NULL;
+}
+
+static void
+push_event (const gchar *name, gint64 ts, gint64 dur)
+{
+    guint h = head;
+    guint used = h - __atomic_load_n (&tail, __ATOMIC_ACQUIRE);
+
+    if (G_UNLIKELY (used >= RING_SIZE))
+    {
+        dropped++;
+        return;
+    }
+
+    t_trace_event *e = &ring[h & (RING_SIZE - 1)];
+    e->name = name;
+    e->ts = ts;
+    e->dur = dur;
+    __atomic_store_n (&head, h + 1, __ATOMIC_RELEASE);
+
+    /* Wake up the writer early if the ring buffer is getting full */
+    if (G_UNLIKELY (used + 1 == RING_SIZE / 2))
+    {
+        g_mutex_lock (&writer_mutex);
+        writer_kicked = true;
+        g_cond_signal (&writer_cond);
+        g_mutex_unlock (&writer_mutex);
+    }
+}
+
+void
+trace_init ()
+{
+    const gchar *path = g_getenv ("SYSTEMLOAD_TRACE");
+    if (trace_active || path == NULL || *path == '\0')
+        return;
+
+    out = fopen (path, "w");
+    if (!out)
+    {
+        g_warning ("Cannot open trace file '%s'", path);
+        return;
+    }
+    fputs ("[\n", out);
+    first_event = true;
+
+    ring = g_new0 (t_trace_event, RING_SIZE);
+    head = tail = dropped = 0;
+    writer_quit = writer_kicked = false;
+    g_mutex_init (&writer_mutex);
+    g_cond_init (&writer_cond);
+    writer = g_thread_new ("systemload-trace", writer_thread, NULL);
+    trace_active = true;
+}
+
+void
+trace_shutdown ()
+{
+    if (!trace_active)
+        return;
+    trace_active = false;
+
+    g_mutex_lock (&writer_mutex);
+    writer_quit = true;
+    g_cond_signal (&writer_cond);
+    g_mutex_unlock (&writer_mutex);
+    g_thread_join (writer);
+    writer = NULL;
+
+    if (dropped != 0)
+        g_warning ("%u trace events were dropped", dropped);
+
+    fputs ("\n]\n", out);
+    fclose (out);
+    out = NULL;
+
+    g_mutex_clear (&writer_mutex);
+    g_cond_clear (&writer_cond);
+    g_free (ring);
+    ring = NULL;
+}
+
+gint64
+trace_begin ()
+{
+    return trace_enabled () ? g_get_monotonic_time () : 0;
+}
+
+void
+trace_end (const gchar *name, gint64 begin)
+{
+    if (!trace_enabled () || begin == 0)
+        return;
+
+    push_event (name, begin, g_get_monotonic_time () - begin);
+}
+
+void
+trace_instant (const gchar *name)
+{
+    if (!trace_enabled ())
+        return;
+
+    push_event (name, g_get_monotonic_time (), -1);
+}
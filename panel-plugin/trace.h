@@ -0,0 +1,80 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_TRACE_H_
+#define _XFCE_SYSTEMLOAD_TRACE_H_
+
+#include <glib.h>
+
+/*
+ * Opt-in export of Chrome/Perfetto JSON trace events. Enabled by setting
+ * the environment variable SYSTEMLOAD_TRACE to the path of the output file.
+ *
+ * Events are stored in a ring buffer allocated once by trace_init() and are
+ * written to the file by a separate thread, the main thread never blocks
+ * on I/O. Events are dropped (and counted) if the ring buffer overflows.
+ * Event names must be string literals or otherwise outlive the trace.
+ */
+
+void     trace_init      ();
+void     trace_shutdown  ();
+
+extern bool trace_active;
+
+static inline bool
+trace_enabled ()
+{
+    return G_UNLIKELY (trace_active);
+}
+
+/* Returns the current monotonic time in microseconds, or 0 if tracing is disabled */
+gint64   trace_begin     ();
+
+/* Records a complete event spanning from begin to now */
+void     trace_end       (const gchar *name, gint64 begin);
+
+/* Records an instant event */
+void     trace_instant   (const gchar *name);
+
+class TraceScope {
+public:
+    explicit TraceScope (const gchar *event_name) : name (event_name), begin (trace_begin ()) {}
+    ~TraceScope () { if (begin != 0) trace_end (name, begin); }
+
+private:
+    TraceScope (const TraceScope&) = delete;
+    TraceScope& operator= (const TraceScope&) = delete;
+
+    const gchar *name;
+    gint64 begin;
+};
+
+#define TRACE_SCOPE_NAME2(line) trace_scope_##line
+#define TRACE_SCOPE_NAME(line) TRACE_SCOPE_NAME2(line)
+#define TRACE_SCOPE(name) TraceScope TRACE_SCOPE_NAME(__LINE__) (name)
+
+#endif /* _XFCE_SYSTEMLOAD_TRACE_H_ */
@@ -37,24 +37,59 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <time.h>
+
+#include "procfs.h"
+#include "scan.h"
+
 #define PROC_UPTIME "/proc/uptime"
 
-gulong read_uptime()
+/* Used only if the kernel doesn't support CLOCK_BOOTTIME */
+static gulong read_proc_uptime()
 {
-    FILE *fd = fopen(PROC_UPTIME, "r");
-    if (!fd) {
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (PROC_UPTIME), &length);
+    if (!contents) {
         g_warning("%s", _("File /proc/uptime not found!"));
         return 0;
     }
 
-    gulong uptime;
-    if (!fscanf(fd, "%lu", &uptime))
+    /* The integer part of the first number */
+    guint64 uptime;
+    if (!scan_number (&contents, contents + length, &uptime))
        uptime = 0;
 
-    fclose(fd);
     return uptime;
 }
 
+/*
+ * CLOCK_BOOTTIME and CLOCK_MONOTONIC both start at boot, the latter stops
+ * while the system is suspended. Both are read from the vDSO without a
+ * system call.
+ */
+gulong read_uptime(bool exclude_suspend, guint *msec)
+{
+    if (msec)
+        *msec = 0;
+
+#ifdef CLOCK_BOOTTIME
+    static bool use_clock = true;
+    if (G_LIKELY (use_clock))
+    {
+        struct timespec ts;
+        if (clock_gettime(exclude_suspend ? CLOCK_MONOTONIC : CLOCK_BOOTTIME, &ts) == 0)
+        {
+            if (msec)
+                *msec = ts.tv_nsec / 1000000;
+            return ts.tv_sec;
+        }
+        use_clock = false;
+    }
+#endif
+
+    return read_proc_uptime();
+}
+
 #elif defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__DragonFly__) || defined(__APPLE__)
 
 #if defined(__NetBSD__) || defined(__APPLE__)
@@ -76,61 +111,209 @@ gulong read_uptime()
 #include <string.h>
 #include <sys/param.h>
 #include <sys/sysctl.h>
+#include <sys/time.h>
 #include <sys/types.h>
 #include <sys/vmmeter.h>
 #include <unistd.h>
 
-#ifdef __FreeBSD__
-#include <sys/time.h>
-#endif /* !__FreeBSD__ */
-
-gulong read_uptime()
+/* The boot time doesn't change, query it only once */
+gulong read_uptime(bool exclude_suspend, guint *msec)
 {
-   int mib[2] = {CTL_KERN, KERN_BOOTTIME};
-   struct timeval boottime;
-   size_t size = sizeof(boottime);
-   gulong uptime;
- 
-   if((sysctl(mib, 2, &boottime, &size, NULL, 0) != -1) && (boottime.tv_sec != 0)) {
-      time_t now;
-      time(&now);
-      uptime = now - boottime.tv_sec;
-   }
-   else
+   static struct timeval boottime;
+   struct timeval now;
+
+   if (boottime.tv_sec == 0)
    {
-       g_warning("Cannot get kern.boottime");
-       uptime = 0;
+      int mib[2] = {CTL_KERN, KERN_BOOTTIME};
+      size_t size = sizeof(boottime);
+      if((sysctl(mib, 2, &boottime, &size, NULL, 0) == -1) || (boottime.tv_sec == 0)) {
+         g_warning("Cannot get kern.boottime");
+         boottime.tv_sec = 0;
+         if (msec)
+            *msec = 0;
+         return 0;
+      }
    }
 
-   return uptime;
+   gettimeofday(&now, NULL);
+   gint64 elapsed_ms = (gint64) (now.tv_sec - boottime.tv_sec) * 1000 +
+                       (now.tv_usec - boottime.tv_usec) / 1000;
+   if (elapsed_ms < 0)
+      elapsed_ms = 0;
+
+   if (msec)
+      *msec = elapsed_ms % 1000;
+   return elapsed_ms / 1000;
 }
 
 #elif defined(__sun__)
 
 #include <kstat.h>
 
-gulong read_uptime()
+/* The boot time doesn't change, query it only once */
+gulong read_uptime(bool exclude_suspend, guint *msec)
 {
-   kstat_ctl_t *kc;
-   kstat_t *ks;
-   kstat_named_t *boottime;
-   gulong uptime;
-
-   if (((kc = kstat_open()) != 0) && ((ks = kstat_lookup(kc, "unix", 0, "system_misc")) != NULL) && (kstat_read(kc, ks, NULL) != -1) && ((boottime = kstat_data_lookup(ks, "boot_time")) != NULL)) {
-      time_t now;
-      time(&now);
-      uptime = now - boottime->value.ul;
-      kstat_close(kc);
-   }
-   else
+   static time_t boot_time;
+
+   if (msec)
+      *msec = 0;
+
+   if (boot_time == 0)
    {
-       g_warning("Cannot get boot_time");
-       uptime = 0;
+      kstat_ctl_t *kc;
+      kstat_t *ks;
+      kstat_named_t *boottime;
+
+      if (((kc = kstat_open()) != 0) && ((ks = kstat_lookup(kc, "unix", 0, "system_misc")) != NULL) && (kstat_read(kc, ks, NULL) != -1) && ((boottime = kstat_data_lookup(ks, "boot_time")) != NULL)) {
+         boot_time = boottime->value.ul;
+      }
+      if (kc)
+         kstat_close(kc);
+
+      if (boot_time == 0)
+      {
+         g_warning("Cannot get boot_time");
+         return 0;
+      }
    }
 
-   return uptime;
+   time_t now;
+   time(&now);
+   return now - boot_time;
 }
 
 #else
 #error "Your platform is not yet supported"
 #endif
+
+#include <string.h>
+
+enum t_uptime_token_kind {
+    TOKEN_LITERAL,
+    TOKEN_DAYS,
+    TOKEN_HOURS,
+    TOKEN_MINUTES,
+    TOKEN_SECONDS,
+};
+
+struct t_uptime_token {
+    t_uptime_token_kind  kind;
+    guint                start, length;  /* Substring of the format, TOKEN_LITERAL only */
+};
+
+struct t_uptime_format {
+    gchar           *text;
+    t_uptime_token  *tokens;
+    guint            n_tokens;
+    gulong           granularity;   /* Seconds per unit of the smallest unit used, 0 if none */
+};
+
+t_uptime_format *
+uptime_format_compile (const gchar *format)
+{
+    auto f = g_new0 (t_uptime_format, 1);
+    gsize len = strlen (format);
+
+    f->text = g_strdup (format);
+    /* At most one token per character */
+    f->tokens = g_new (t_uptime_token, len + 1);
+
+    for (gsize i = 0; i < len; )
+    {
+        t_uptime_token_kind kind = TOKEN_LITERAL;
+        gulong unit = 0;
+
+        if (format[i] == '%')
+        {
+            switch (format[i + 1])
+            {
+            case 'd': kind = TOKEN_DAYS; unit = 86400; break;
+            case 'h': kind = TOKEN_HOURS; unit = 3600; break;
+            case 'm': kind = TOKEN_MINUTES; unit = 60; break;
+            case 's': kind = TOKEN_SECONDS; unit = 1; break;
+            default: break;
+            }
+        }
+
+        if (kind != TOKEN_LITERAL)
+        {
+            f->tokens[f->n_tokens++] = { kind, 0, 0 };
+            if (f->granularity == 0 || unit < f->granularity)
+                f->granularity = unit;
+            i += 2;
+        }
+        else if (f->n_tokens != 0 && f->tokens[f->n_tokens - 1].kind == TOKEN_LITERAL)
+        {
+            f->tokens[f->n_tokens - 1].length++;
+            i++;
+        }
+        else
+        {
+            f->tokens[f->n_tokens++] = { TOKEN_LITERAL, (guint) i, 1 };
+            i++;
+        }
+    }
+
+    return f;
+}
+
+void
+uptime_format_free (t_uptime_format *format)
+{
+    if (format)
+    {
+        g_free (format->text);
+        g_free (format->tokens);
+        g_free (format);
+    }
+}
+
+void
+uptime_format_render (const t_uptime_format *format, gulong uptime, gchar *buf, gsize size)
+{
+    gsize pos = 0;
+
+    g_return_if_fail (size != 0);
+
+    for (guint i = 0; i < format->n_tokens && pos < size - 1; i++)
+    {
+        const t_uptime_token *t = &format->tokens[i];
+        gulong value;
+
+        switch (t->kind)
+        {
+        case TOKEN_LITERAL:
+        {
+            gsize n = MIN (t->length, size - 1 - pos);
+            memcpy (buf + pos, format->text + t->start, n);
+            pos += n;
+            continue;
+        }
+        case TOKEN_DAYS:    value = uptime / 86400; break;
+        case TOKEN_HOURS:   value = (uptime / 3600) % 24; break;
+        case TOKEN_MINUTES: value = (uptime / 60) % 60; break;
+        default:            value = uptime % 60; break;
+        }
+
+        /* Digits in reverse order */
+        gchar digits[24];
+        guint n = 0;
+        do {
+            digits[n++] = '0' + value % 10;
+            value /= 10;
+        } while (value != 0);
+
+        while (n != 0 && pos < size - 1)
+            buf[pos++] = digits[--n];
+    }
+
+    buf[pos] = '\0';
+}
+
+gulong
+uptime_format_next_change (const t_uptime_format *format, gulong uptime)
+{
+    if (format->granularity == 0)
+        return 0;
+    return format->granularity - uptime % format->granularity;
+}
@@ -31,6 +31,27 @@
 
 #include <glib.h>
 
-gulong read_uptime();
+/*
+ * Returns the uptime in seconds, and the milliseconds elapsed since the last
+ * full second in msec (may be NULL). Time spent in suspend is excluded if
+ * exclude_suspend is true and the platform allows it (Linux only).
+ */
+gulong read_uptime(bool exclude_suspend, guint *msec);
+
+/*
+ * The uptime label format ("%d", "%h", "%m" and "%s" stand for days, hours,
+ * minutes and seconds) compiled into a list of tokens, so that rendering
+ * the label doesn't need to search the format string.
+ */
+struct t_uptime_format;
+
+t_uptime_format *uptime_format_compile (const gchar *format);
+void             uptime_format_free    (t_uptime_format *format);
+
+/* Renders the label into buf, always NUL-terminated */
+void             uptime_format_render  (const t_uptime_format *format, gulong uptime, gchar *buf, gsize size);
+
+/* Seconds until the rendered label changes, 0 if it never changes */
+gulong           uptime_format_next_change (const t_uptime_format *format, gulong uptime);
 
 #endif /* _XFCE_SYSTEMLOAD_UPTIME_H_ */
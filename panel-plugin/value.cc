@@ -0,0 +1,312 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "value.h"
+
+
+
+
+/* Rates below 10 units are shown with one decimal, like "3.4G" */
+#define RATE_KEYS (100 + 990)
+
+static const gchar *const RATE_UNIT[] = { "", "K", "M", "G", "T" };
+
+const gchar *const PERCENT_RESERVED[1] = { "100%" };
+const gchar *const RATE_RESERVED[5] = { "999", "999K", "999M", "999G", "999T" };
+
+static gchar        percent_cache[101][sizeof ("100%")];
+static gchar       *rate_cache[G_N_ELEMENTS (RATE_UNIT)][RATE_KEYS];
+
+
+
+static void                 systemload_value_finalize               (GObject          *object);
+static void                 systemload_value_style_updated          (GtkWidget        *widget);
+static gboolean             systemload_value_draw                   (GtkWidget        *widget,
+                                                                     cairo_t          *cr);
+static void                 systemload_value_get_preferred_width    (GtkWidget        *widget,
+                                                                     gint             *minimum,
+                                                                     gint             *natural);
+static void                 systemload_value_get_preferred_height   (GtkWidget        *widget,
+                                                                     gint             *minimum,
+                                                                     gint             *natural);
+
+
+
+struct _SystemloadValueClass {
+  GtkWidgetClass   __parent__;
+};
+
+struct _SystemloadValue {
+  GtkWidget           __parent__;
+
+  PangoLayout        *layout;
+  const gchar        *text;
+  bool                vertical;
+
+  const gchar *const *reserved;
+  guint               n_reserved;
+  gint                reserved_width;
+  gint                reserved_height;
+};
+
+
+
+G_DEFINE_TYPE (SystemloadValue, systemload_value, GTK_TYPE_WIDGET)
+
+
+
+static void
+systemload_value_class_init (SystemloadValueClass *klass)
+{
+  GObjectClass   *gobject_class;
+  GtkWidgetClass *widget_class;
+
+  gobject_class                      = G_OBJECT_CLASS (klass);
+  gobject_class->finalize            = systemload_value_finalize;
+
+  widget_class                       = GTK_WIDGET_CLASS (klass);
+  widget_class->style_updated        = systemload_value_style_updated;
+  widget_class->draw                 = systemload_value_draw;
+  widget_class->get_preferred_width  = systemload_value_get_preferred_width;
+  widget_class->get_preferred_height = systemload_value_get_preferred_height;
+
+  gtk_widget_class_set_css_name (widget_class, "systemloadvalue");
+}
+
+
+
+static void
+systemload_value_init (SystemloadValue *value)
+{
+  gtk_widget_set_has_window (GTK_WIDGET (value), FALSE);
+
+  value->layout = gtk_widget_create_pango_layout (GTK_WIDGET (value), NULL);
+  value->text = "";
+}
+
+
+
+static void
+systemload_value_finalize (GObject *object)
+{
+  SystemloadValue *value = SYSTEMLOAD_VALUE (object);
+
+  g_object_unref (value->layout);
+
+  G_OBJECT_CLASS (systemload_value_parent_class)->finalize (object);
+}
+
+
+
+/* Measures the reserved strings, the only place where the size of the widget is computed */
+static void
+systemload_value_measure (SystemloadValue *value)
+{
+  gint width = 0, height = 0;
+
+  for (guint i = 0; i < value->n_reserved; i++)
+    {
+      gint w, h;
+      pango_layout_set_text (value->layout, value->reserved[i], -1);
+      pango_layout_get_pixel_size (value->layout, &w, &h);
+      width = MAX (width, w);
+      height = MAX (height, h);
+    }
+
+  pango_layout_set_text (value->layout, value->text, -1);
+  if (value->n_reserved == 0)
+    pango_layout_get_pixel_size (value->layout, &width, &height);
+
+  value->reserved_width = width;
+  value->reserved_height = height;
+}
+
+
+
+static void
+systemload_value_style_updated (GtkWidget *widget)
+{
+  SystemloadValue *value = SYSTEMLOAD_VALUE (widget);
+
+  GTK_WIDGET_CLASS (systemload_value_parent_class)->style_updated (widget);
+
+  /* The font may have changed */
+  pango_layout_context_changed (value->layout);
+  systemload_value_measure (value);
+  gtk_widget_queue_resize (widget);
+}
+
+
+
+static gboolean
+systemload_value_draw (GtkWidget *widget, cairo_t *cr)
+{
+  SystemloadValue *value = SYSTEMLOAD_VALUE (widget);
+  GtkStyleContext *context = gtk_widget_get_style_context (widget);
+  gint width = gtk_widget_get_allocated_width (widget);
+  gint height = gtk_widget_get_allocated_height (widget);
+  gint text_width, text_height;
+
+  pango_layout_get_pixel_size (value->layout, &text_width, &text_height);
+
+  if (value->vertical)
+    {
+      /* Rotate by -90 degrees, the text runs from the bottom to the top */
+      cairo_translate (cr, 0, height);
+      cairo_rotate (cr, -G_PI / 2);
+      gint tmp = width;
+      width = height;
+      height = tmp;
+    }
+
+  gtk_render_layout (context, cr, (width - text_width) / 2, (height - text_height) / 2, value->layout);
+
+  return FALSE;
+}
+
+
+
+static void
+systemload_value_get_preferred_width (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  SystemloadValue *value = SYSTEMLOAD_VALUE (widget);
+
+  *minimum = *natural = value->vertical ? value->reserved_height : value->reserved_width;
+}
+
+
+
+static void
+systemload_value_get_preferred_height (GtkWidget *widget, gint *minimum, gint *natural)
+{
+  SystemloadValue *value = SYSTEMLOAD_VALUE (widget);
+
+  *minimum = *natural = value->vertical ? value->reserved_width : value->reserved_height;
+}
+
+
+
+GtkWidget *
+systemload_value_new (void)
+{
+  return GTK_WIDGET (g_object_new (TYPE_SYSTEMLOAD_VALUE, NULL));
+}
+
+
+
+void
+systemload_value_set_reserved (SystemloadValue *value, const gchar *const *texts, guint n_texts)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_VALUE (value));
+
+  if (value->reserved == texts && value->n_reserved == n_texts)
+    return;
+
+  value->reserved = texts;
+  value->n_reserved = n_texts;
+  systemload_value_measure (value);
+  gtk_widget_queue_resize (GTK_WIDGET (value));
+}
+
+
+
+void
+systemload_value_set_text (SystemloadValue *value, const gchar *text)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_VALUE (value));
+
+  /* The text is one of the cached strings, no need to compare the contents */
+  if (value->text == text)
+    return;
+
+  value->text = text;
+  pango_layout_set_text (value->layout, text, -1);
+  gtk_widget_queue_draw (GTK_WIDGET (value));
+}
+
+
+
+void
+systemload_value_set_vertical (SystemloadValue *value, bool vertical)
+{
+  g_return_if_fail (IS_SYSTEMLOAD_VALUE (value));
+
+  if (value->vertical == vertical)
+    return;
+
+  value->vertical = vertical;
+  gtk_widget_queue_resize (GTK_WIDGET (value));
+}
+
+
+
+const gchar *
+systemload_value_format_percent (guint percent)
+{
+  percent = MIN (percent, 100);
+
+  gchar *s = percent_cache[percent];
+  if (G_UNLIKELY (s[0] == '\0'))
+    g_snprintf (s, sizeof (percent_cache[0]), "%u%%", percent);
+  return s;
+}
+
+
+
+const gchar *
+systemload_value_format_rate (guint64 bits_per_second)
+{
+  guint unit = 0;
+  guint key;
+  gdouble mantissa = bits_per_second;
+
+  /* Plain bits per second are always integers */
+  while (mantissa >= 999.5 && unit < G_N_ELEMENTS (RATE_UNIT) - 1)
+    {
+      mantissa /= 1000;
+      unit++;
+    }
+
+  if (unit == 0)
+    key = (guint) mantissa;
+  else if (mantissa < 9.95)
+    key = (guint) (mantissa * 10 + 0.5);
+  else
+    key = 100 + (guint) MIN (mantissa + 0.5, 999.0) - 10;
+
+  gchar *s = rate_cache[unit][key];
+  if (G_UNLIKELY (s == NULL))
+    {
+      if (unit != 0 && key < 100)
+        s = g_strdup_printf ("%u.%u%s", key / 10, key % 10, RATE_UNIT[unit]);
+      else
+        s = g_strdup_printf ("%u%s", unit == 0 ? key : key - 100 + 10, RATE_UNIT[unit]);
+      rate_cache[unit][key] = s;
+    }
+  return s;
+}
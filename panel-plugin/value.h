@@ -0,0 +1,80 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_VALUE_H_
+#define _XFCE_SYSTEMLOAD_VALUE_H_
+
+#include <gtk/gtk.h>
+
+/*
+ * A text widget showing the live value of a monitor, like "42%".
+ *
+ * Unlike GtkLabel, changing the text never renegotiates the size of the
+ * panel: the size is reserved for the widest of a set of strings and the
+ * text only triggers a redraw. The texts are not copied, the strings
+ * returned by the format functions below stay valid for the lifetime of
+ * the plugin, so that an unchanged value is a pointer comparison.
+ */
+
+typedef struct _SystemloadValueClass SystemloadValueClass;
+typedef struct _SystemloadValue      SystemloadValue;
+
+#define TYPE_SYSTEMLOAD_VALUE             (systemload_value_get_type ())
+#define SYSTEMLOAD_VALUE(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), TYPE_SYSTEMLOAD_VALUE, SystemloadValue))
+#define SYSTEMLOAD_VALUE_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass),  TYPE_SYSTEMLOAD_VALUE, SystemloadValueClass))
+#define IS_SYSTEMLOAD_VALUE(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), TYPE_SYSTEMLOAD_VALUE))
+#define IS_SYSTEMLOAD_VALUE_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass),  TYPE_SYSTEMLOAD_VALUE))
+#define SYSTEMLOAD_VALUE_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj),  TYPE_SYSTEMLOAD_VALUE, SystemloadValueClass))
+
+GType              systemload_value_get_type          (void) G_GNUC_CONST;
+
+GtkWidget         *systemload_value_new               (void);
+
+/* The strings must outlive the widget, like the string literals of the PERCENT_RESERVED and RATE_RESERVED tables */
+void               systemload_value_set_reserved      (SystemloadValue      *value,
+                                                       const gchar *const   *texts,
+                                                       guint                 n_texts);
+
+/* The string must stay valid until the next call */
+void               systemload_value_set_text          (SystemloadValue      *value,
+                                                       const gchar          *text);
+
+/* Draws the text rotated by -90 degrees, like gtk_label_set_angle(label, -90) */
+void               systemload_value_set_vertical      (SystemloadValue      *value,
+                                                       bool                  vertical);
+
+/* Widest strings returned by systemload_value_format_percent() and systemload_value_format_rate() */
+extern const gchar *const PERCENT_RESERVED[1];
+extern const gchar *const RATE_RESERVED[5];
+
+/* "42%", value in the range 0 ... 100 */
+const gchar       *systemload_value_format_percent    (guint                 percent);
+
+/* "3.4G", bits per second with SI prefixes */
+const gchar       *systemload_value_format_rate       (guint64               bits_per_second);
+
+#endif /* _XFCE_SYSTEMLOAD_VALUE_H_ */
@@ -0,0 +1,135 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "vmstat.h"
+
+#ifdef __linux__
+
+#include "procfs.h"
+#include "scan.h"
+
+enum {
+    SWAP_IN,
+    SWAP_OUT,
+    MAJOR_FAULTS,
+    REFAULTS,
+    ALLOC_STALLS,
+    OOM_KILLS,
+    N_COUNTERS,
+};
+
+struct t_vmstat_field {
+    const gchar *name;
+    bool         prefix;    /* Sum of all counters starting with name, like allocstall_normal */
+    guint        counter;
+};
+
+static const t_vmstat_field VMSTAT_FIELDS[] = {
+    { "pswpin",             false, SWAP_IN },
+    { "pswpout",            false, SWAP_OUT },
+    { "pgmajfault",         false, MAJOR_FAULTS },
+    { "workingset_refault", true,  REFAULTS },        /* _anon and _file since Linux 5.9 */
+    { "allocstall",         true,  ALLOC_STALLS },    /* Per zone since Linux 4.8 */
+    { "oom_kill",           false, OOM_KILLS },
+};
+
+/* Counters of the previous read */
+static guint64 prev[N_COUNTERS];
+static gint64  prev_time;
+
+gint
+read_vmstat (t_vmstat *vmstat)
+{
+    const gchar *filepath = "/proc/vmstat";
+    gsize length;
+    const gchar *contents = procfs_read (procfs_open (filepath), &length);
+    if (!contents)
+    {
+        g_warning ("Cannot read '%s'", filepath);
+        return -1;
+    }
+
+    /* Lines look like "pgmajfault 289" */
+    guint64 counters[N_COUNTERS] = { 0 };
+    const gchar *end = contents + length;
+    for (const gchar *p = contents; p < end; p++)
+    {
+        const gchar *eol = scan_line_end (p, end);
+        const gchar *space = (const gchar*) memchr (p, ' ', eol - p);
+        if (space)
+        {
+            const gsize key_length = space - p;
+            for (guint i = 0; i < G_N_ELEMENTS (VMSTAT_FIELDS); i++)
+            {
+                const t_vmstat_field *field = &VMSTAT_FIELDS[i];
+                const gsize name_length = strlen (field->name);
+                guint64 value;
+                if ((key_length == name_length || (field->prefix && key_length > name_length)) &&
+                    memcmp (p, field->name, name_length) == 0)
+                {
+                    if (scan_number (&space, eol, &value))
+                        counters[field->counter] += value;
+                    break;
+                }
+            }
+        }
+        p = eol;
+    }
+
+    gint64 now = g_get_monotonic_time ();
+    const gdouble seconds = prev_time != 0 ? (now - prev_time) / (gdouble) G_USEC_PER_SEC : 0;
+    prev_time = now;
+
+    gdouble rates[N_COUNTERS];
+    guint64 deltas[N_COUNTERS];
+    for (guint i = 0; i < N_COUNTERS; i++)
+    {
+        deltas[i] = seconds > 0 && counters[i] >= prev[i] ? counters[i] - prev[i] : 0;
+        rates[i] = seconds > 0 ? deltas[i] / seconds : 0;
+        prev[i] = counters[i];
+    }
+
+    vmstat->swap_in = rates[SWAP_IN];
+    vmstat->swap_out = rates[SWAP_OUT];
+    vmstat->major_faults = rates[MAJOR_FAULTS];
+    vmstat->refaults = rates[REFAULTS];
+    vmstat->alloc_stalls = rates[ALLOC_STALLS];
+    vmstat->oom_kills = deltas[OOM_KILLS];
+    return 0;
+}
+
+#else
+
+gint
+read_vmstat (t_vmstat *vmstat)
+{
+    return -1;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_VMSTAT_H_
+#define _XFCE_SYSTEMLOAD_VMSTAT_H_
+
+#include <glib.h>
+
+/*
+ * Paging activity from the counters of /proc/vmstat. Unlike the occupancy
+ * of the swap, these rates tell whether the machine is thrashing.
+ */
+
+struct t_vmstat {
+    gdouble swap_in;        /* Pages per second */
+    gdouble swap_out;       /* Pages per second */
+    gdouble major_faults;   /* Per second */
+    gdouble refaults;       /* Evicted pages read again, per second */
+    gdouble alloc_stalls;   /* Allocations waiting for direct reclaim, per second */
+    guint64 oom_kills;      /* Since the previous read */
+};
+
+/* Returns 0 on success, the rates are 0 after the first read */
+gint    read_vmstat     (t_vmstat *vmstat);
+
+#endif /* _XFCE_SYSTEMLOAD_VMSTAT_H_ */